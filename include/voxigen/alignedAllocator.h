@@ -0,0 +1,52 @@
+#ifndef _voxigen_alignedAllocator_h_
+#define _voxigen_alignedAllocator_h_
+
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+namespace voxigen
+{
+
+//std allocator returning _Alignment aligned memory (power of 2), the original malloc
+//pointer is stored just before the returned address
+template<typename _Type, size_t _Alignment>
+struct AlignedAllocator
+{
+    typedef _Type value_type;
+
+    template<typename _Other>
+    struct rebind { typedef AlignedAllocator<_Other, _Alignment> other; };
+
+    AlignedAllocator() {}
+    template<typename _Other>
+    AlignedAllocator(const AlignedAllocator<_Other, _Alignment> &) {}
+
+    _Type *allocate(size_t count)
+    {
+        void *memory=std::malloc((count*sizeof(_Type))+_Alignment+sizeof(void *));
+
+        if(!memory)
+            throw std::bad_alloc();
+
+        uintptr_t address=(reinterpret_cast<uintptr_t>(memory)+sizeof(void *)+_Alignment-1)&~(uintptr_t)(_Alignment-1);
+
+        reinterpret_cast<void **>(address)[-1]=memory;
+        return reinterpret_cast<_Type *>(address);
+    }
+
+    void deallocate(_Type *pointer, size_t)
+    {
+        if(pointer)
+            std::free(reinterpret_cast<void **>(pointer)[-1]);
+    }
+};
+
+template<typename _Type, typename _Other, size_t _Alignment>
+bool operator==(const AlignedAllocator<_Type, _Alignment> &, const AlignedAllocator<_Other, _Alignment> &) { return true; }
+template<typename _Type, typename _Other, size_t _Alignment>
+bool operator!=(const AlignedAllocator<_Type, _Alignment> &, const AlignedAllocator<_Other, _Alignment> &) { return false; }
+
+}//namespace voxigen
+
+#endif //_voxigen_alignedAllocator_h_
@@ -0,0 +1,98 @@
+#ifndef _voxigen_asyncIo_h_
+#define _voxigen_asyncIo_h_
+
+#include "voxigen/voxigen_export.h"
+#include "voxigen/processRequests.h"
+#include "voxigen/queueThread.h"
+
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+
+struct io_uring_sqe;
+
+namespace voxigen
+{
+
+//positional file read, filled in by the prepare callback and read by the io backend
+struct IoOperation
+{
+    IoOperation():file(-1), offset(0), flags(0), result(0) {}
+
+    int file;                 //native file descriptor
+    uint64_t offset;          //file offset
+    uint32_t flags;           //passed through to complete callback
+    std::vector<char> buffer; //read target, sized by prepare
+    int64_t result;           //bytes read, negative errno on failure
+};
+
+//Services Read/Write requests on a pool of threads. Requests the prepare callback
+//accepts are read with positional async reads, io_uring when available (Linux)
+//otherwise pread on the pool threads, then handed to the complete callback on a
+//pool thread (the ring thread only reaps completions). Anything else is run through
+//the process callback on the pool threads.
+class VOXIGEN_EXPORT AsyncIo
+{
+public:
+    typedef std::vector<process::Request *> RequestQueue;
+    typedef std::function<bool(process::Request *, IoOperation &)> PrepareCallback;
+    typedef std::function<bool(process::Request *, IoOperation &)> CompleteCallback;
+
+    AsyncIo(std::condition_variable *completeEvent);
+    ~AsyncIo();
+
+    void setCallback(process::Callback callback);
+    void setAsyncCallbacks(PrepareCallback prepare, CompleteCallback complete);
+
+    //queueDepth is the max number of reads in flight on the ring
+    void start(size_t threadCount=2, size_t queueDepth=64);
+    void stop();
+
+    void updateQueue(RequestQueue &queue, RequestQueue &cancelQueue, RequestQueue &completedQueue, bool forceResort);
+
+    bool usingIoUring() const { return m_ring!=nullptr; }
+
+    bool defaultCallback(process::Request *request) { return true; }
+    bool defaultPrepare(process::Request *request, IoOperation &operation) { return false; }
+    bool defaultComplete(process::Request *request, IoOperation &operation) { return true; }
+
+private:
+    struct Ring;
+
+    //pool thread callback
+    bool processRequest(process::Request *request);
+    static bool readBlocking(IoOperation &operation);
+    //ring read done, hands the request back to the pool threads for the complete callback
+    void requeueRead(process::Request *request, IoOperation &operation);
+    bool takeRead(process::Request *request, IoOperation &operation);
+    //completes reads the pool threads did not get to before stopping
+    void completeReads();
+
+    bool startRing(size_t queueDepth);
+    void stopRing();
+    //next free submission entry, nullptr if the queue stays full
+    io_uring_sqe *getSqe();
+    bool submitRing(process::Request *request, IoOperation &operation);
+    void ringThread();
+    //ring wait failed, finishes the reads still in flight
+    void failRing();
+
+    QueueThread m_queueThread;
+
+    process::Callback processCallback;
+    PrepareCallback prepareCallback;
+    CompleteCallback completeCallback;
+
+    std::unique_ptr<Ring> m_ring;
+    std::thread m_ringThread;
+
+    std::mutex m_readMutex;
+    std::unordered_map<process::Request *, IoOperation> m_completedReads;
+};
+
+}//namespace voxigen
+
+#endif //_voxigen_asyncIo_h_
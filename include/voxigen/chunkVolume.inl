@@ -23,7 +23,7 @@ typename ChunkSampler<_ChunkVolume>::VoxelType ChunkSampler<_ChunkVolume>::getVo
     assert(glm::all(glm::greaterThanEqual(m_position, m_minPosition)));
     assert(glm::all(glm::lessThan(m_position, m_maxPosition)));
 
-    CellType &cell=m_chunk->getCell(m_position);
+    CellType cell=m_chunk->getCell(m_position);
 
     return cell.type;
 }
@@ -42,9 +42,11 @@ bool ChunkSampler<_ChunkVolume>::setVoxel(VoxelType tValue)
     assert(glm::all(glm::greaterThanEqual(m_position, m_minPosition)));
     assert(glm::all(glm::lessThan(m_position, m_maxPosition)));
 
-    CellType &cell=m_chunk->getCell(m_position);
+    CellType cell=m_chunk->getCell(m_position);
 
     cell.type=tValue;
+    m_chunk->setCell(m_chunk->getCellIndex(m_position), cell);
+    return true;
 }
 
 template<typename _ChunkVolume>
@@ -94,7 +96,7 @@ typename ChunkSampler<_ChunkVolume>::VoxelType ChunkSampler<_ChunkVolume>::peek(
     if(glm::any(glm::greaterThanEqual(position, m_maxPosition)))
         return 0;
 
-    CellType &cell=m_chunk->getCell(position);
+    CellType cell=m_chunk->getCell(position);
 
     return cell.type;
 }
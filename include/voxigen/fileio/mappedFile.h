@@ -0,0 +1,44 @@
+#ifndef _voxigen_mappedFile_h_
+#define _voxigen_mappedFile_h_
+
+#include "voxigen/voxigen_export.h"
+
+#include <string>
+#include <memory>
+
+namespace voxigen
+{
+
+//Read only memory map of an entire file
+class VOXIGEN_EXPORT MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &)=delete;
+    MappedFile &operator=(const MappedFile &)=delete;
+
+    bool open(const std::string &fileName);
+    void close();
+
+    bool isOpen() const { return m_data!=nullptr; }
+
+    const char *data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+#ifdef _WIN32
+    void *m_file;
+    void *m_mapping;
+#else
+    int m_file;
+#endif
+    const char *m_data;
+    size_t m_size;
+};
+typedef std::shared_ptr<MappedFile> SharedMappedFile;
+
+} //namespace voxigen
+
+#endif //_voxigen_mappedFile_h_
@@ -36,6 +36,12 @@ inline bool create_directory(const std::string &name) { return create_directory(
 VOXIGEN_EXPORT void copy_file(const char *src, const char *dest, bool replace);
 inline void copy_file(const std::string &src, const std::string &dest, bool replace) { copy_file(src.c_str(), dest.c_str(), replace); }
 
+VOXIGEN_EXPORT bool rename(const char *src, const char *dest);
+inline bool rename(const std::string &src, const std::string &dest) { return rename(src.c_str(), dest.c_str()); }
+
+VOXIGEN_EXPORT bool remove(const char *name);
+inline bool remove(const std::string &name) { return remove(name.c_str()); }
+
 VOXIGEN_EXPORT void extension(const char *file, char *value, size_t &size);
 inline std::string extension(const char *file)
 {
@@ -78,6 +84,37 @@ inline std::vector<std::string> get_directories(const char *directory)
 }
 inline std::vector<std::string> get_directories(const std::string &directory) { return get_directories(directory.c_str()); }
 
+//file names (with extension) of the regular files in directory
+VOXIGEN_EXPORT void get_files(const char *directory, char **files, size_t *sizes, size_t &size);
+inline std::vector<std::string> get_files(const char *directory)
+{
+    size_t size;
+
+    get_files(directory, nullptr, nullptr, size);
+
+    std::vector<size_t> sizes;
+
+    sizes.resize(size);
+    get_files(directory, nullptr, sizes.data(), size);
+    sizes.resize(size);
+
+    std::vector<std::string> files;
+    std::vector<char *> filesChar;
+
+    files.resize(size);
+    filesChar.resize(size);
+    for(size_t i=0; i<size; ++i)
+    {
+        files[i].resize(sizes[i]);
+        filesChar[i]=&(files[i])[0];
+    }
+
+    get_files(directory, filesChar.data(), sizes.data(), size);
+    files.resize(size);
+    return files;
+}
+inline std::vector<std::string> get_files(const std::string &directory) { return get_files(directory.c_str()); }
+
 }
 }//namespace voxigen::fs
 
@@ -0,0 +1,53 @@
+#ifndef _voxigen_columnCache_h_
+#define _voxigen_columnCache_h_
+
+#include "voxigen/lruCache.h"
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace voxigen
+{
+
+//chunk column footprint, x,y grid position of the chunk start
+struct ColumnKey
+{
+    ColumnKey():x(0), y(0), lod(0) {}
+    ColumnKey(int x, int y, size_t lod):x(x), y(y), lod((uint32_t)lod) {}
+
+    bool operator==(const ColumnKey &key) const { return (x==key.x)&&(y==key.y)&&(lod==key.lod); }
+
+    int x;
+    int y;
+    uint32_t lod;
+};
+
+struct ColumnKeyHash
+{
+    size_t operator()(const ColumnKey &key) const
+    {
+        uint64_t value=((uint64_t)(uint32_t)key.x<<32)|(uint32_t)key.y;
+
+        value^=(uint64_t)key.lod*0x9e3779b97f4a7c15ull;
+        return std::hash<uint64_t>()(value);
+    }
+};
+
+//continent noise for a chunk column at lod stride
+struct ColumnHeightMap
+{
+    std::vector<float> heights;
+};
+typedef std::shared_ptr<const ColumnHeightMap> SharedColumnHeightMap;
+
+//column height maps shared by all generator threads, bounded by entry count
+class ColumnCache:public LruCache<ColumnKey, ColumnHeightMap, ColumnKeyHash>
+{
+public:
+    ColumnCache(size_t capacity=1024):LruCache(capacity) {}
+};
+
+}//namespace voxigen
+
+#endif //_voxigen_columnCache_h_
@@ -4,10 +4,13 @@
 #include "voxigen/voxigen_export.h"
 #include "voxigen/volume/chunk.h"
 #include "voxigen/volume/gridDescriptors.h"
+#include "voxigen/generators/generator.h"
+#include "voxigen/generators/columnCache.h"
 #include "voxigen/maths/coords.h"
 #include "voxigen/meshes/heightMap.h"
 #include "voxigen/noise.h"
 #include "voxigen/generators/tectonics.h"
+#include "voxigen/generators/influenceMap.h"
 #include "voxigen/generators/weather.h"
 #include "voxigen/generators/perturbedWeather.h"
 #include "voxigen/wrap.h"
@@ -15,6 +18,7 @@
 #include "voxigen/maths/math_helpers.h"
 #include "voxigen/sortedVector.h"
 #include "voxigen/loadProgress.h"
+#include "voxigen/parallelFor.h"
 
 #include "voxigen/maths/glm_point.h"
 #define GLM_ENABLE_EXPERIMENTAL
@@ -23,8 +27,13 @@
 #undef None
 
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <array>
 #include <random>
 #include <chrono>
+#include <limits>
+#include <algorithm>
 namespace chrono=std::chrono;
 
 namespace voxigen
@@ -99,7 +108,17 @@ struct VOXIGEN_EXPORT EquiRectDescriptors
     glm::ivec2 m_influenceGridSize;
 };
 
+//overview.bin (version 3)
+//  header
+//  influence map field arrays (InfluenceMap::forEachArray order), each x*y values starting
+//  at a InfluenceMap_Alignment aligned offset, the file is mapped and the arrays used in place
+//normalize.bin (version 2)
+//  header
+//  neighbor heights (size floats) at a InfluenceMap_Alignment aligned offset
 constexpr unsigned int EquiRectWorldGeneratorHeader_Marker=0x0f0f0f0f;
+constexpr unsigned int EquiRectWorldGeneratorHeader_Version=3;
+constexpr unsigned int NormalizeHeader_Version=2;
+
 struct EquiRectWorldGeneratorHeader
 {
     unsigned int marker;
@@ -107,7 +126,9 @@ struct EquiRectWorldGeneratorHeader
     unsigned int x;
     unsigned int y;
     unsigned int cellSize;
-    unsigned int size;
+    unsigned int size; //bytes of array data, including alignment padding
+    unsigned int alignment;
+    unsigned int reserved;
 };
 
 struct NormalizeHeader
@@ -119,15 +140,19 @@ struct NormalizeHeader
 
 struct ThreadStorage
 {
-    std::vector<float> heightMap;
-    std::vector<float> blockHeightMap;
-    std::vector<float> blockScaleMap;
+    SharedColumnHeightMap column;
+    //surface height of each x,y in the column, from buildColumn
+    std::vector<int> surfaceHeights;
     std::vector<float> xMap;
     std::vector<float> yMap;
     std::vector<float> zMap;
     std::vector<float> layerMap;
     std::unique_ptr<HastyNoise::VectorSet> vectorSet;
 
+    //height range of the column currently in the maps
+    int columnMinHeight;
+    int columnMaxHeight;
+
     std::vector<float> regionHeightMap;
     std::unique_ptr<HastyNoise::VectorSet> regionVectorSet;
 };
@@ -141,7 +166,7 @@ public:
     typedef typename _Grid::ChunkType ChunkType;
     typedef std::unique_ptr<ChunkType> UniqueChunkType;
 
-    typedef std::vector<InfluenceCell> InfluenceMap;
+    typedef voxigen::InfluenceMap InfluenceMap;
 
     EquiRectWorldGenerator();
     ~EquiRectWorldGenerator();
@@ -158,15 +183,26 @@ public:
     void saveDescriptors(IGridDescriptors *descriptors);
     void saveDescriptors(std::string &descriptors);
     //    void initialize(IGridDescriptors *descriptors);
+    //continent noise used for the column heights, the overview passes reconfigure it
+    void initContinentNoise();
     //    void setWorld(GridDescriptors descriptors);
     //    void setWorldDiscriptors(GridDescriptors descriptors);
 
     void generateWorldOverview(LoadProgress &progress);
+    //threads used by the overview passes, 0 uses the hardware thread count. The overview
+    //is the same for any thread count
+    void setOverviewThreads(size_t threads) { m_overviewThreads=threads; }
 
     //    UniqueChunkType generateChunk(unsigned int hash, void *buffer, size_t bufferSize);
     //    UniqueChunkType generateChunk(glm::ivec3 chunkIndex, void *buffer, size_t bufferSize);
     //    UniqueChunkType generateChunk(unsigned int hash, glm::ivec3 &chunkIndex, void *buffer, size_t bufferSize);
-    unsigned int generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod);
+    unsigned int generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod, bool &uniform);
+    void generateChunks(const glm::ivec3 &chunkSize, size_t lod, GenerateChunkRequest *chunks, size_t count);
+    //bounds the surface under the chunk from the influence map (no noise), chunks entirely
+    //above or deep below it are written as a single cell, returns false if the chunk has to be generated
+    bool classifyChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, size_t lod, void *buffer, size_t bufferSize, unsigned int &validCells);
+    //generateChunk(s) only classify when enabled (default), off every chunk is built from its column
+    void setClassifyChunks(bool classify) { m_classifyChunks=classify; }
     unsigned int generateRegion(const glm::vec3 &startPos, const glm::ivec3 &regionSize, void *buffer, size_t bufferSize, size_t lod);
 
     int getBaseHeight(const glm::vec2 &pos);
@@ -178,6 +214,9 @@ public:
 
     EquiRectDescriptors &getDecriptors() { return m_descriptorValues; }
 
+    //column height maps shared between chunk and region generation, has hit/miss counters
+    ColumnCache &getColumnCache() { return m_columnCache; }
+
     int m_plateSeed;
     int m_plateCount;
     std::vector<glm::vec2> m_influencePoints;
@@ -195,7 +234,18 @@ private:
     template<typename _FileIO>
     void saveNormalize(const std::string &fileName);
 
-    void buildHeightMap(const glm::vec3 &startPos, const glm::ivec3 &lodSize, size_t stride);
+    void buildHeightMap(const glm::vec3 &startPos, const glm::ivec3 &lodSize, size_t stride, std::vector<float> &heightMap);
+    //chunk column continent noise from the cache, built on miss
+    SharedColumnHeightMap getColumnHeightMap(const glm::vec3 &startPos, size_t lod);
+    //2d part of chunk generation, fills height/block maps in thread storage for the x,y column
+    void buildColumn(const glm::vec3 &startPos, size_t lod);
+    //min/max surface height possible in the chunk column, from the influence neighbor heights
+    //and the continent noise range
+    void getColumnHeightRange(const glm::vec3 &startPos, int &minHeight, int &maxHeight);
+    //chunk above maxHeight (air) or deep enough below minHeight (single type), cell written to buffer[0]
+    bool uniformChunk(const glm::vec3 &startPos, size_t lod, int minHeight, int maxHeight, void *buffer, unsigned int &validCells);
+    //fills a chunk from the column built by buildColumn
+    unsigned int fillChunk(const glm::vec3 &startPos, void *buffer, size_t bufferSize, size_t lod, bool &uniform);
 
     void generatePlates(LoadProgress &progress);
     void generateContinents(LoadProgress &progress);
@@ -214,10 +264,15 @@ private:
     int m_continentSeed;
 
     InfluenceMap m_influenceMap;
-    std::vector<float> m_influenceNeighborMap;
+    InfluenceField<float> m_influenceNeighborMap;
 
     std::unique_ptr<HastyNoise::VectorSet> m_influenceVectorSet;
 
+    ColumnCache m_columnCache;
+
+    size_t m_overviewThreads;
+    bool m_classifyChunks;
+
     //    Regular2DGrid<InfluenceCell> m_influence;
     //    noise::module::Perlin m_perlin;
     //    noise::module::Perlin m_continentPerlin;
@@ -28,10 +28,26 @@ thread_local ThreadStorage EquiRectWorldGenerator<_Grid>::m_threadStorage;
 //template<typename _Grid>
 //std::unique_ptr<HastyNoise::VectorSet> EquiRectWorldGenerator<_Grid>::regionVectorSet;
 
+inline float lerp(float v0, float v1, float t)
+{
+    return (1-t)*v0+t*v1;
+}
+
+inline float bi_lerp(float v00, float v10, float v01, float v11, float t0, float t1)
+{
+    return lerp(lerp(v00, v10, t0), lerp(v01, v11, t0), t1);
+}
+
+//cells per block of the parallel overview passes, fixed so the output does not depend on
+//the thread count
+const size_t OverviewBlockSize=4096;
+
 template<typename _Grid>
 EquiRectWorldGenerator<_Grid>::EquiRectWorldGenerator()
 {
     m_plateCount=16;
+    m_overviewThreads=0;
+    m_classifyChunks=true;
     initNoise();//make sure noise dlls are loaded
 }
 
@@ -57,6 +73,8 @@ void EquiRectWorldGenerator<_Grid>::initialize(IGridDescriptors *descriptors)
         saveDescriptors(m_descriptors->m_generatorDescriptors);
 
     m_descriptorValues.init(m_descriptors);
+    //new world, cached columns are stale
+    m_columnCache.clear();
 
     //    m_descriptors=descriptors;
     //    assert(m_descriptors!=nullptr);
@@ -65,14 +83,8 @@ void EquiRectWorldGenerator<_Grid>::initialize(IGridDescriptors *descriptors)
     int seed=m_descriptors->m_seed;
     m_simdLevel=HastyNoise::GetFastestSIMD();
 
-    m_continentPerlin=HastyNoise::CreateNoise(seed, m_simdLevel);
-
     m_continentSeed=seed;
-    m_continentPerlin->SetNoiseType(HastyNoise::NoiseType::PerlinFractal);
-    m_continentPerlin->SetFrequency(m_descriptorValues.m_continentFrequency);
-    m_continentPerlin->SetFractalLacunarity(m_descriptorValues.m_continentLacunarity);
-    m_continentPerlin->SetFractalOctaves(m_descriptorValues.m_continentOctaves);
-    
+    initContinentNoise();
 
     m_layersPerlin=HastyNoise::CreateNoise(seed+1, m_simdLevel);
 
@@ -95,6 +107,17 @@ void EquiRectWorldGenerator<_Grid>::initialize(IGridDescriptors *descriptors)
 //    generateWorldOverview();
 }
 
+template<typename _Grid>
+void EquiRectWorldGenerator<_Grid>::initContinentNoise()
+{
+    m_continentPerlin=HastyNoise::CreateNoise(m_continentSeed, m_simdLevel);
+
+    m_continentPerlin->SetNoiseType(HastyNoise::NoiseType::PerlinFractal);
+    m_continentPerlin->SetFrequency(m_descriptorValues.m_continentFrequency);
+    m_continentPerlin->SetFractalLacunarity(m_descriptorValues.m_continentLacunarity);
+    m_continentPerlin->SetFractalOctaves(m_descriptorValues.m_continentOctaves);
+}
+
 template<typename _Grid>
 void EquiRectWorldGenerator<_Grid>::loadDescriptors(IGridDescriptors *descriptors)
 {
@@ -186,43 +209,71 @@ void EquiRectWorldGenerator<_Grid>::generateWorldOverview(LoadProgress &progress
 
     generatePlates(progress);
     //    generateContinents();
+
+    //chunks have to match the ones from a loaded overview, which never ran the passes
+    initContinentNoise();
+    m_columnCache.clear();
 }
 
 template<typename _Grid>
 template<typename _FileIO>
 bool EquiRectWorldGenerator<_Grid>::loadWorldOverview(const std::string &fileName)
 {
-    typedef generic::io::fs<_FileIO> fs;
+    //mapped and used in place, nothing is read until the generator touches it
+    SharedMappedFile mapping=std::make_shared<MappedFile>();
 
-    fs::Type *file=fs::open(fileName, "rb");
+    if(!mapping->open(fileName))
+        return false;
 
-    if(!file)
+    if(mapping->size()<sizeof(EquiRectWorldGeneratorHeader))
         return false;
 
     EquiRectWorldGeneratorHeader header;
-    
-    size_t readSize=fs::read(&header, 1, sizeof(EquiRectWorldGeneratorHeader), file);
 
-    if(readSize != sizeof(EquiRectWorldGeneratorHeader))
-        return false;
+    memcpy(&header, mapping->data(), sizeof(EquiRectWorldGeneratorHeader));
 
     if(header.marker != EquiRectWorldGeneratorHeader_Marker)
         return false;
 
-    if(header.cellSize!=sizeof(InfluenceCell))
+    //older versions are not aligned, regenerate
+    if(header.version!=EquiRectWorldGeneratorHeader_Version)
+        return false;
+
+    if((header.alignment!=InfluenceMap_Alignment)||(header.cellSize!=m_influenceMap.cellSize()))
+        return false;
+
+    //saved for another world size, the arrays would not cover this map
+    if((header.x!=(unsigned int)m_descriptorValues.m_influenceSize.x)||(header.y!=(unsigned int)m_descriptorValues.m_influenceSize.y))
         return false;
 
     size_t influenceMapSize=header.x*header.y;
+    size_t dataOffset=alignInfluenceOffset(sizeof(EquiRectWorldGeneratorHeader));
 
-    if(header.size!=influenceMapSize*sizeof(InfluenceCell))
+    if(mapping->size()<dataOffset+header.size)
         return false;
 
-    m_influenceMap.resize(influenceMapSize);
+    size_t offset=dataOffset;
+    bool valid=true;
 
-    readSize=fs::read(m_influenceMap.data(), sizeof(InfluenceCell), influenceMapSize, file);
-    fs::close(file);
+    m_influenceMap.forEachArray([&](auto &array)
+    {
+        typedef typename std::decay<decltype(array)>::type::value_type ValueType;
 
-    return (readSize == influenceMapSize);
+        offset=alignInfluenceOffset(offset);
+        if(offset+(influenceMapSize*sizeof(ValueType))>dataOffset+header.size)
+        {
+            valid=false;
+            return;
+        }
+
+        array.view((const ValueType *)(mapping->data()+offset), influenceMapSize, mapping);
+        offset+=influenceMapSize*sizeof(ValueType);
+    });
+
+    if(!valid)
+        m_influenceMap.resize(0);
+
+    return valid;
 }
 
 template<typename _Grid>
@@ -231,24 +282,49 @@ void EquiRectWorldGenerator<_Grid>::saveWorldOverview(const std::string &fileNam
 {
     typedef generic::io::fs<_FileIO> fs;
 
+    //the map may be a view of this file, truncating it would pull the pages out from under it
+    m_influenceMap.unmap();
+
     fs::Type *file=fs::open(fileName, "wb");
 
     if(!file)
         return;
 
     EquiRectWorldGeneratorHeader header;
+    size_t dataOffset=alignInfluenceOffset(sizeof(EquiRectWorldGeneratorHeader));
+    size_t offset=dataOffset;
 
     header.marker=EquiRectWorldGeneratorHeader_Marker;
-    header.version=1;
+    header.version=EquiRectWorldGeneratorHeader_Version;
     header.x=m_descriptorValues.m_influenceSize.x;
     header.y=m_descriptorValues.m_influenceSize.y;
-    header.cellSize=sizeof(InfluenceCell);
-    header.size=header.x*header.y*sizeof(InfluenceCell);
+    header.cellSize=m_influenceMap.cellSize();
+    header.alignment=InfluenceMap_Alignment;
+    header.reserved=0;
+
+    m_influenceMap.forEachArray([&](auto &array)
+    {
+        offset=alignInfluenceOffset(offset)+(array.size()*sizeof(array[0]));
+    });
+    header.size=offset-dataOffset;
 
     assert(m_influenceMap.size()==(header.x*header.y));
 
+    static const char padding[InfluenceMap_Alignment]={0};
+
     fs::write(&header, sizeof(EquiRectWorldGeneratorHeader), 1, file);
-    fs::write(m_influenceMap.data(), sizeof(InfluenceCell), m_influenceMap.size(), file);
+    offset=sizeof(EquiRectWorldGeneratorHeader);
+
+    m_influenceMap.forEachArray([&](auto &array)
+    {
+        size_t alignedOffset=alignInfluenceOffset(offset);
+
+        if(alignedOffset!=offset)
+            fs::write(padding, 1, alignedOffset-offset, file);
+
+        fs::write(array.data(), sizeof(array[0]), array.size(), file);
+        offset=alignedOffset+(array.size()*sizeof(array[0]));
+    });
     fs::close(file);
 }
 
@@ -256,29 +332,34 @@ template<typename _Grid>
 template<typename _FileIO>
 bool EquiRectWorldGenerator<_Grid>::loadNormalize(const std::string &fileName)
 {
-    typedef generic::io::fs<_FileIO> fs;
+    SharedMappedFile mapping=std::make_shared<MappedFile>();
 
-    fs::Type *file=fs::open(fileName, "rb");
+    if(!mapping->open(fileName))
+        return false;
 
-    if(!file)
+    if(mapping->size()<sizeof(NormalizeHeader))
         return false;
 
     NormalizeHeader header;
 
-    size_t readSize=fs::read(&header, 1, sizeof(NormalizeHeader), file);
+    memcpy(&header, mapping->data(), sizeof(NormalizeHeader));
+
+    if(header.marker != EquiRectWorldGeneratorHeader_Marker)
+        return false;
 
-    if(readSize != sizeof(NormalizeHeader))
+    if(header.version!=NormalizeHeader_Version)
         return false;
 
-    if(header.marker != EquiRectWorldGeneratorHeader_Marker)
+    if(header.size!=m_influenceMap.size()*NeighborCount)
         return false;
 
-    m_influenceNeighborMap.resize(header.size);
+    size_t dataOffset=alignInfluenceOffset(sizeof(NormalizeHeader));
 
-    readSize=fs::read(m_influenceNeighborMap.data(), sizeof(float), header.size, file);
-    fs::close(file);
+    if(mapping->size()<dataOffset+(header.size*sizeof(float)))
+        return false;
 
-    return (readSize == header.size);
+    m_influenceNeighborMap.view((const float *)(mapping->data()+dataOffset), header.size, mapping);
+    return true;
 }
 
 template<typename _Grid>
@@ -287,6 +368,8 @@ void EquiRectWorldGenerator<_Grid>::saveNormalize(const std::string &fileName)
 {
     typedef generic::io::fs<_FileIO> fs;
 
+    m_influenceNeighborMap.unmap();
+
     fs::Type *file=fs::open(fileName, "wb");
 
     if(!file)
@@ -295,10 +378,13 @@ void EquiRectWorldGenerator<_Grid>::saveNormalize(const std::string &fileName)
     NormalizeHeader header;
 
     header.marker=EquiRectWorldGeneratorHeader_Marker;
-    header.version=1;
+    header.version=NormalizeHeader_Version;
     header.size=m_influenceNeighborMap.size();
 
+    static const char padding[InfluenceMap_Alignment]={0};
+
     fs::write(&header, sizeof(NormalizeHeader), 1, file);
+    fs::write(padding, 1, alignInfluenceOffset(sizeof(NormalizeHeader))-sizeof(NormalizeHeader), file);
     fs::write(m_influenceNeighborMap.data(), sizeof(float), m_influenceNeighborMap.size(), file);
     fs::close(file);
 }
@@ -376,24 +462,23 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
     allocationTime=chrono::duration_cast<chrono::milliseconds>(time2-time1).count();
 
     progress.update("Generating coordinates", 10, false);
-    glm::vec3 mapPos;
-    size_t index=0;
-    mapPos.z=(float)(influenceSize.x/2.0f);
-    for(int y=0; y<influenceSize.y; y++)
+    parallelFor(influenceMapSize, OverviewBlockSize, [&](size_t block, size_t begin, size_t end)
     {
-        mapPos.y=y;
-        for(int x=0; x<influenceSize.x; x++)
+        glm::vec3 mapPos;
+
+        mapPos.z=(float)(influenceSize.x/2.0f);
+        for(size_t index=begin; index<end; index++)
         {
-            mapPos.x=x;
+            mapPos.x=(float)(index%influenceSize.x);
+            mapPos.y=(float)(index/influenceSize.x);
             glm::vec3 pos=getSphericalCoords(influenceSize.x, influenceSize.y, mapPos);
 
             //hasty treats x and y in reverse, need to change
             m_influenceVectorSet->xSet[index]=pos.y;
             m_influenceVectorSet->ySet[index]=pos.x;
             m_influenceVectorSet->zSet[index]=pos.z;
-            index++;
         }
-    }
+    }, m_overviewThreads);
 
     time1=chrono::high_resolution_clock::now();
     coordsTime=chrono::duration_cast<chrono::milliseconds>(time1-time2).count();
@@ -478,29 +563,40 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
 
     time1=chrono::high_resolution_clock::now();
 
-    float last=-2.0f;
-    std::vector<float> plates;
+    size_t overviewBlocks=parallelBlockCount(influenceMapSize, OverviewBlockSize);
+    std::vector<std::vector<float>> blockPlates(overviewBlocks);
 
-    //find and index all plates
-    for(size_t i=0; i<influenceMapSize; i++)
+    //find and index all plates, each block finds its own then they are merged
+    parallelFor(influenceMapSize, OverviewBlockSize, [&](size_t block, size_t begin, size_t end)
     {
-        if(plateMap[i]==last)
-            continue;
-        else if(contains_sorted(plates, plateMap[i]))
+        std::vector<float> &found=blockPlates[block];
+        float last=-2.0f;
+
+        for(size_t i=begin; i<end; i++)
         {
+            if(plateMap[i]==last)
+                continue;
+            else if(contains_sorted(found, plateMap[i]))
+            {
+                last=plateMap[i];
+                continue;
+            }
+
+            insert_sorted(found, plateMap[i]);
             last=plateMap[i];
-            continue;
         }
+    }, m_overviewThreads);
 
-        insert_sorted(plates, plateMap[i]);
-        last=plateMap[i];
-    }
+    std::vector<float> plates;
 
-    last=-2.0f;
-    size_t lastIndex=0;
-    float last2=-2.0f;
-    size_t last2Index=0;
-    glm::ivec2 point={0, 0};
+    for(const std::vector<float> &found:blockPlates)
+    {
+        for(float plate:found)
+        {
+            if(!contains_sorted(plates, plate))
+                insert_sorted(plates, plate);
+        }
+    }
 
     //setup plates
     std::default_random_engine generator(m_descriptors->m_seed);
@@ -513,6 +609,9 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
     std::vector<int> plateNeighbors;
     std::vector<int> plateCollisions;
 
+    //plate ids are stored compact in the influence map
+    assert(plates.size()<=std::numeric_limits<InfluenceIndex>::max());
+
     plateDetails.resize(plates.size());
     plateNeighbors.resize(plates.size()*plates.size(), 0);
     plateMinDistance.resize(plates.size(), 2.0f);
@@ -523,69 +622,118 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
 
     progress.update("Generating height map", 50, false);
 
-    for(size_t i=0; i<influenceMapSize; i++)
+    //plate stats are gathered per block and merged in block order, first block to reach
+    //a min keeps it and points stay in map order so the result does not depend on threads
+    struct PlateBlock
     {
-        if(plateMap[i]!=last)
-        {
-            lastIndex=index_sorted(plates, plateMap[i]);
-            last=plateMap[i];
-        }
+        std::vector<char> neighbors;
+        std::vector<float> minDistance;
+        std::vector<float> maxDistance;
+        std::vector<glm::ivec2> minPoint;
+        std::vector<std::vector<glm::ivec2>> points;
+    };
+    std::vector<PlateBlock> plateBlocks(overviewBlocks);
 
-        if(plate2Map[i]!=last2)
+    parallelFor(influenceMapSize, OverviewBlockSize, [&](size_t block, size_t begin, size_t end)
+    {
+        PlateBlock &plateBlock=plateBlocks[block];
+        float last=-2.0f;
+        size_t lastIndex=0;
+        float last2=-2.0f;
+        size_t last2Index=0;
+        glm::ivec2 point((int)(begin%influenceSize.x), (int)(begin/influenceSize.x));
+
+        plateBlock.neighbors.resize(plates.size()*plates.size(), 0);
+        plateBlock.minDistance.resize(plates.size(), 2.0f);
+        plateBlock.maxDistance.resize(plates.size(), -2.0f);
+        plateBlock.minPoint.resize(plates.size());
+        plateBlock.points.resize(plates.size());
+
+        for(size_t i=begin; i<end; i++)
         {
-            last2Index=index_sorted(plates, plate2Map[i]);
+            if(plateMap[i]!=last)
+            {
+                lastIndex=index_sorted(plates, plateMap[i]);
+                last=plateMap[i];
+            }
 
-            if(last2Index==std::numeric_limits<size_t>::max())
+            if(plate2Map[i]!=last2)
             {
-                //plate we haven't seen, setting to current plate
-                last2Index=lastIndex;
-                last2=plateMap[i];
+                last2Index=index_sorted(plates, plate2Map[i]);
+
+                if(last2Index==std::numeric_limits<size_t>::max())
+                {
+                    //plate we haven't seen, setting to current plate
+                    last2Index=lastIndex;
+                    last2=plateMap[i];
+                }
+                else
+                    last2=plate2Map[i];
             }
-            else
-                last2=plate2Map[i];
-        }
 
-        if(lastIndex!=last2Index)
-        {
-            size_t neighborIndex=lastIndex*plates.size()+last2Index;
+            if(lastIndex!=last2Index)
+                plateBlock.neighbors[lastIndex*plates.size()+last2Index]=1;
 
-            if(!plateNeighbors[neighborIndex])
-                plateNeighbors[neighborIndex]=1;
-        }
+            if(plateDistanceMap[i]<plateBlock.minDistance[lastIndex])
+            {
+                plateBlock.minDistance[lastIndex]=plateDistanceMap[i];
+                plateBlock.minPoint[lastIndex]=point;
+            }
 
-        if(plateDistanceMap[i]<plateMinDistance[lastIndex])
-        {
-            plateMinDistance[lastIndex]=plateDistanceMap[i];
-            plateMinPoint[lastIndex]=point;
-        }
+            if(plateDistanceMap[i]>plateBlock.maxDistance[lastIndex])
+                plateBlock.maxDistance[lastIndex]=plateDistanceMap[i];
 
-        if(plateDistanceMap[i]>plateMaxDistance[lastIndex])
-            plateMaxDistance[lastIndex]=plateDistanceMap[i];
+            assert(last2Index<plates.size());
 
-        assert(last2Index<plates.size());
+            m_influenceMap.tectonicPlate[i]=(InfluenceIndex)lastIndex;
+            m_influenceMap.borderPlate[i]=(InfluenceIndex)last2Index;
+            m_influenceMap.plateHeight[i]=(last)*0.1f+0.5f;
+            m_influenceMap.plateValue[i]=last;
+            m_influenceMap.plateDistanceValue[i]=plateDistanceMap[i];
+            m_influenceMap.continentValue[i]=continentMap[i];
 
-        m_influenceMap[i].tectonicPlate=lastIndex;
-        m_influenceMap[i].borderPlate=last2Index;
-        m_influenceMap[i].plateHeight=(last)*0.1f+0.5f;
-        m_influenceMap[i].plateValue=last;
-        m_influenceMap[i].plateDistanceValue=plateDistanceMap[i];
-        m_influenceMap[i].continentValue=continentMap[i];
+//            glm::vec2 airDirection(ewAirCurrent[i], nsAirCurrent[i]);
+//            
+//            m_influenceMap.airDirection[i]=glm::normalize(airDirection);
+            m_influenceMap.airDirection[i].x=ewAirCurrent[i];
+            m_influenceMap.airDirection[i].y=nsAirCurrent[i];
 
-//        glm::vec2 airDirection(ewAirCurrent[i], nsAirCurrent[i]);
-//        
-//        m_influenceMap[i].airDirection=glm::normalize(airDirection);
-        m_influenceMap[i].airDirection.x=ewAirCurrent[i];
-        m_influenceMap[i].airDirection.y=nsAirCurrent[i];
+            plateBlock.points[lastIndex].emplace_back(point.x, point.y);
 
-        plateDetails[lastIndex].points.emplace_back(point.x, point.y);
+            point.x++;
+            if(point.x>=influenceSize.x)
+            {
+                point.x=0;
+                point.y++;
+            }
+        }
+    }, m_overviewThreads);
 
-        point.x++;
-        if(point.x>=influenceSize.x)
+    for(PlateBlock &plateBlock:plateBlocks)
+    {
+        for(size_t j=0; j<plateNeighbors.size(); j++)
         {
-            point.x=0;
-            point.y++;
+            if(plateBlock.neighbors[j])
+                plateNeighbors[j]=1;
+        }
+
+        for(size_t j=0; j<plates.size(); j++)
+        {
+            if(plateBlock.minDistance[j]<plateMinDistance[j])
+            {
+                plateMinDistance[j]=plateBlock.minDistance[j];
+                plateMinPoint[j]=plateBlock.minPoint[j];
+            }
+
+            if(plateBlock.maxDistance[j]>plateMaxDistance[j])
+                plateMaxDistance[j]=plateBlock.maxDistance[j];
+
+            std::vector<glm::ivec2> &points=plateDetails[j].points;
+
+            points.insert(points.end(), plateBlock.points[j].begin(), plateBlock.points[j].end());
         }
     }
+    plateBlocks.clear();
 
     progress.update("Generating tectonic zones", 55, false);
 
@@ -680,132 +828,137 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
 
     progress.update("Generating influence map", 60, false);
 
-    point={0, 0};
-    for(size_t i=0; i<influenceMapSize; i++)
+    //every cell only reads the plate details, cells are independent
+    parallelFor(influenceMapSize, OverviewBlockSize, [&](size_t block, size_t begin, size_t end)
     {
-        size_t &index=m_influenceMap[i].tectonicPlate;
-        size_t &borderIndex=m_influenceMap[i].borderPlate;
+        glm::ivec2 point((int)(begin%influenceSize.x), (int)(begin/influenceSize.x));
 
-        PlateInfo &details=plateDetails[index];
-        PlateInfo &details2=plateDetails[borderIndex];
+        for(size_t i=begin; i<end; i++)
+        {
+            size_t index=m_influenceMap.tectonicPlate[i];
+            size_t borderIndex=m_influenceMap.borderPlate[i];
 
-        float collision;
+            PlateInfo &details=plateDetails[index];
+            PlateInfo &details2=plateDetails[borderIndex];
 
-        if(!details.neighbors.empty())
-        {
-            size_t neighborIndex=0;
+            float collision;
 
-            for(size_t j=0; j<details.neighbors.size(); ++j)
+            if(!details.neighbors.empty())
             {
-                if(details.neighbors[j]==borderIndex)
-                    neighborIndex=j;
-            }
+                size_t neighborIndex=0;
+
+                for(size_t j=0; j<details.neighbors.size(); ++j)
+                {
+                    if(details.neighbors[j]==borderIndex)
+                        neighborIndex=j;
+                }
             
-            collision=details.neighborCollisions[neighborIndex];
-        }
-        else
-            collision=0.0f;
+                collision=details.neighborCollisions[neighborIndex];
+            }
+            else
+                collision=0.0f;
 
-        //normalize distance
-        m_influenceMap[i].plateDistanceValue=(plateDistanceMap[i]-plateMinDistance[index])/(plateMaxDistance[index]-plateMinDistance[index]);
-//        m_influenceMap[i].heightBase=0.0f;
+            //normalize distance
+            m_influenceMap.plateDistanceValue[i]=(plateDistanceMap[i]-plateMinDistance[index])/(plateMaxDistance[index]-plateMinDistance[index]);
+//        m_influenceMap.heightBase[i]=0.0f;
 
 //build per pixel direction
-        glm::vec3 sphericalPoint;
-        glm::vec3 cartPoint;
-        glm::vec3 direction;
-        glm::vec3 sphericalDirection;
-
-        glm::vec2 normPoint((float)point.x/influenceSize.x, (float)point.y/influenceSize.y);
-        projectPoint<Projections::Equirectangular, Projections::Spherical>(normPoint, sphericalPoint);
-        projectPoint<Projections::Spherical, Projections::Cartesian>(sphericalPoint, cartPoint);
+            glm::vec3 sphericalPoint;
+            glm::vec3 cartPoint;
+            glm::vec3 direction;
+            glm::vec3 sphericalDirection;
+
+            glm::vec2 normPoint((float)point.x/influenceSize.x, (float)point.y/influenceSize.y);
+            projectPoint<Projections::Equirectangular, Projections::Spherical>(normPoint, sphericalPoint);
+            projectPoint<Projections::Spherical, Projections::Cartesian>(sphericalPoint, cartPoint);
         
-        rotateTangetVectorToPoint(cartPoint, details.driftDirection, direction);
+            rotateTangetVectorToPoint(cartPoint, details.driftDirection, direction);
 
-        projectVector(direction, sphericalPoint, sphericalDirection);
-        m_influenceMap[i].direction.x=sphericalDirection.y;
-        m_influenceMap[i].direction.y=sphericalDirection.z;
+            projectVector(direction, sphericalPoint, sphericalDirection);
+            m_influenceMap.direction[i].x=sphericalDirection.y;
+            m_influenceMap.direction[i].y=sphericalDirection.z;
 
 //air currents determined by banding and random vectors from before
-        glm::vec2 latLong(sphericalPoint.y, sphericalPoint.z);
-        float latitude=sphericalPoint.z;
-        float dir=1.0f;
-        glm::vec2 bandDirection;
+            glm::vec2 latLong(sphericalPoint.y, sphericalPoint.z);
+            float latitude=sphericalPoint.z;
+            float dir=1.0f;
+            glm::vec2 bandDirection;
 
-        if(sphericalPoint.z<0.0f)
-            dir=-1.0f;
+            if(sphericalPoint.z<0.0f)
+                dir=-1.0f;
 
-        m_influenceMap[i].weatherCell=weather.getCellIndex(latLong);
-        m_influenceMap[i].weatherBand=weather.getBandIndex(latLong);
+            m_influenceMap.weatherCell[i]=(InfluenceIndex)weather.getCellIndex(latLong);
+            m_influenceMap.weatherBand[i]=(InfluenceIndex)weather.getBandIndex(latLong);
 
-        bandDirection=weather.getWindDirection(latLong);
-        m_influenceMap[i].airDirection=bandDirection;
-//        m_influenceMap[i].airDirection=(bandDirection+m_influenceMap[i].airDirection)/2.0f;
+            bandDirection=weather.getWindDirection(latLong);
+            m_influenceMap.airDirection[i]=bandDirection;
+//        m_influenceMap.airDirection[i]=(bandDirection+m_influenceMap.airDirection[i])/2.0f;
 
 //build terrain
-        bool oceanPlate=(details.height<0.5f);
-        bool oceanPlate2=(details2.height<0.5f);
+            bool oceanPlate=(details.height<0.5f);
+            bool oceanPlate2=(details2.height<0.5f);
 
-        float plateScale;
-        float plate2Scale;
-        float terrainScale=0.0f;
+            float plateScale;
+            float plate2Scale;
+            float terrainScale=0.0f;
 
-		if((oceanPlate && !oceanPlate2) || (!oceanPlate&&oceanPlate2))
-			calculateCurve(m_influenceMap[i].plateDistanceValue, plateScale, plate2Scale, 0.7f);
-		else
-			calculateCurve(m_influenceMap[i].plateDistanceValue, plateScale, plate2Scale, 0.5f);
+			if((oceanPlate && !oceanPlate2) || (!oceanPlate&&oceanPlate2))
+				calculateCurve(m_influenceMap.plateDistanceValue[i], plateScale, plate2Scale, 0.7f);
+			else
+				calculateCurve(m_influenceMap.plateDistanceValue[i], plateScale, plate2Scale, 0.5f);
         
 //        if(i>51450)
 //            i=i;
 
-        if(index != borderIndex)
-        {
-            m_influenceMap[i].collision=collision;
-
-            if(collision<0.0f) //divergent boundary
+            if(index != borderIndex)
             {
-                collision=-(collision);//reverse negative as following is expecting collision to be a magnitude
-                terrainScale=calculateDivergentCurve(m_influenceMap[i].plateDistanceValue, oceanPlate, oceanPlate2);
+                m_influenceMap.collision[i]=collision;
+
+                if(collision<0.0f) //divergent boundary
+                {
+                    collision=-(collision);//reverse negative as following is expecting collision to be a magnitude
+                    terrainScale=calculateDivergentCurve(m_influenceMap.plateDistanceValue[i], oceanPlate, oceanPlate2);
+                }
+                else if(collision>0.0f) //convergent boundary
+                    terrainScale=calculateConvergentCurve(m_influenceMap.plateDistanceValue[i], oceanPlate, oceanPlate2);
             }
-            else if(collision>0.0f) //convergent boundary
-                terrainScale=calculateConvergentCurve(m_influenceMap[i].plateDistanceValue, oceanPlate, oceanPlate2);
-        }
-        else
-            m_influenceMap[i].collision=0.0f;
+            else
+                m_influenceMap.collision[i]=0.0f;
 
-        float genHeight=(heightMap[i]+1.0f)*0.05f;
-        float genTerrainScale=(terrainScaleMap[i]+1.0f)*0.2f+0.2f;
+            float genHeight=(heightMap[i]+1.0f)*0.05f;
+            float genTerrainScale=(terrainScaleMap[i]+1.0f)*0.2f+0.2f;
 
-        m_influenceMap[i].heightBase=((details.height+genHeight)*plateScale)+(details2.height*plate2Scale)+(terrainScale*collision*genTerrainScale);// *0.4f);
+            m_influenceMap.heightBase[i]=((details.height+genHeight)*plateScale)+(details2.height*plate2Scale)+(terrainScale*collision*genTerrainScale);// *0.4f);
         
-        m_influenceMap[i].terrainScale=terrainScale;
+            m_influenceMap.terrainScale[i]=terrainScale;
 
-		if(m_influenceMap[i].heightBase>1.0f)
-			m_influenceMap[i].heightBase=1.0f;
-		if(m_influenceMap[i].heightBase<0.0f)
-			m_influenceMap[i].heightBase=0.0f;
+			if(m_influenceMap.heightBase[i]>1.0f)
+				m_influenceMap.heightBase[i]=1.0f;
+			if(m_influenceMap.heightBase[i]<0.0f)
+				m_influenceMap.heightBase[i]=0.0f;
 
 //temperature
-        m_influenceMap[i].temperature=getTemperature(latitude);
+            m_influenceMap.temperature[i]=getTemperature(latitude);
 
 //moisture
-        float bandMoisture=weather.getMoisture(latLong);
+            float bandMoisture=weather.getMoisture(latLong);
 
-        m_influenceMap[i].moistureCapacity=bandMoisture*0.5f;
-        if(m_influenceMap[i].heightBase<0.5)
-            moistureMap[i]=1.0f;
-        //        if(m_influenceMap[i].heightBase<0.5)
-        //            moistureMap[i]=1.0f*(m_influenceMap[i].heightBase-0.25f)/0.25f;
-        else
-            moistureMap[i]=(bandMoisture*0.9)+(nsAirCurrent[i]*0.1f);// *0.5f;
+            m_influenceMap.moistureCapacity[i]=bandMoisture*0.5f;
+            if(m_influenceMap.heightBase[i]<0.5)
+                moistureMap[i]=1.0f;
+            //        if(m_influenceMap.heightBase[i]<0.5)
+            //            moistureMap[i]=1.0f*(m_influenceMap.heightBase[i]-0.25f)/0.25f;
+            else
+                moistureMap[i]=(bandMoisture*0.9)+(nsAirCurrent[i]*0.1f);// *0.5f;
 
-        point.x++;
-        if(point.x>=influenceSize.x)
-        {
-            point.x=0;
-            point.y++;
+            point.x++;
+            if(point.x>=influenceSize.x)
+            {
+                point.x=0;
+                point.y++;
+            }
         }
-    }
+    }, m_overviewThreads);
 
     progress.update("Generating moisture", 70, false);
 //    std::vector<float> *mapPointer1=&moistureMap;
@@ -813,7 +966,7 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
     std::vector<float> &map1=moistureMap;
     for(size_t i=0; i<influenceMapSize; i++)
     {
-        if(m_influenceMap[i].heightBase>0.5f)
+        if(m_influenceMap.heightBase[i]>0.5f)
             moistureDeltaMap[i]=0.0f;
         else
             moistureDeltaMap[i]=1.0f;
@@ -844,12 +997,12 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
 
                 if(map1[i]>0.0f)
                 {
-                    glm::vec2 &airDirection=m_influenceMap[i].airDirection;
+                    glm::vec2 &airDirection=m_influenceMap.airDirection[i];
                     float magnitude=glm::length(airDirection);
                     float moisture=moistureDeltaMap[i];// map1[i];
-                    float moistureCaptured=moisture*m_influenceMap[i].moistureCapacity*magnitude;
+                    float moistureCaptured=moisture*m_influenceMap.moistureCapacity[i]*magnitude;
 
-                    if(m_influenceMap[i].heightBase>0.5f)
+                    if(m_influenceMap.heightBase[i]>0.5f)
                         moistureDeltaMap[i]=moistureDeltaMap[i]-moistureCaptured;
 
                     fillPoints(glm::vec2(x, y), airDirection, moistureDeltaMap, influenceSize, moistureCaptured);
@@ -876,7 +1029,7 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
     {
 //        std::vector<float> &map=*mapPointer1;
         
-        m_influenceMap[i].moisture=std::max(std::min(map1[i]+moistureDeltaMap[i], 1.0f), 0.0f);
+        m_influenceMap.moisture[i]=std::max(std::min(map1[i]+moistureDeltaMap[i], 1.0f), 0.0f);
     }
 
     time2=chrono::high_resolution_clock::now();
@@ -884,7 +1037,8 @@ void EquiRectWorldGenerator<_Grid>::generatePlates(LoadProgress &progress)
 
     m_plateCount=plates.size();
 
-//    updateInfluenceNeighbors();
+    //chunk generation reads the neighbor heights, a freshly generated overview needs them too
+    updateInfluenceNeighbors();
 }
 
 template<typename _Grid>
@@ -895,6 +1049,22 @@ void EquiRectWorldGenerator<_Grid>::generateContinents(LoadProgress &progress)
 //    m_cellularNoise->SetFractalOctaves(m_descriptorValues.m_plateOctaves);
 }
 
+//getBlockType returns the same type for any block deeper than this
+const int UniformBlockDepth=11;
+
+//layers of a column from the top, air above the surface then the same types getBlockType
+//gives by depth. Chunk fill works out the layer from the depth boundaries once per column
+const size_t ColumnLayerCount=3;
+const std::array<unsigned int, ColumnLayerCount> columnLayerTypes={0, 1, 2};
+//deepest block (surface-depth) of the top layer
+const int TopLayerDepth=2;
+
+//layer of block z in a column with surface height
+inline size_t columnLayer(int z, int surfaceHeight)
+{
+    return (size_t)(z<=surfaceHeight)+(size_t)(z<surfaceHeight-TopLayerDepth);
+}
+
 template<bool useStride>
 int getBlockType(int z, size_t columnHeight, size_t stride)
 {
@@ -932,15 +1102,103 @@ inline int getBlockType<true>(int z, size_t columnHeight, size_t stride)
 }
 
 template<typename _Grid>
-unsigned int EquiRectWorldGenerator<_Grid>::generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod)
+unsigned int EquiRectWorldGenerator<_Grid>::generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod, bool &uniform)
 {
-    if(!m_threadStorage.vectorSet)
-        m_threadStorage.vectorSet=std::make_unique<HastyNoise::VectorSet>(m_simdLevel);
-    
+    //verify chunkSize matches template chunk size
+    assert(chunkSize==glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value));
 
-//    glm::vec3 offset=glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)*chunkIndex;
-    glm::vec3 scaledOffset=startPos*m_descriptorValues.m_noiseScale;
-    glm::vec3 position=scaledOffset;
+    unsigned int validCells;
+
+    //most chunks in a column are air or solid, skip the noise for those
+    if(m_classifyChunks && classifyChunk(startPos, chunkSize, lod, buffer, bufferSize, validCells))
+    {
+        uniform=true;
+        return validCells;
+    }
+
+    buildColumn(startPos, lod);
+    return fillChunk(startPos, buffer, bufferSize, lod, uniform);
+}
+
+template<typename _Grid>
+bool EquiRectWorldGenerator<_Grid>::classifyChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, size_t lod, void *buffer, size_t bufferSize, unsigned int &validCells)
+{
+    assert(bufferSize>=sizeof(typename ChunkType::CellType));
+
+    //overview not generated/loaded
+    if(m_influenceNeighborMap.empty())
+        return false;
+
+    int minHeight;
+    int maxHeight;
+
+    getColumnHeightRange(startPos, minHeight, maxHeight);
+    return uniformChunk(startPos, lod, minHeight, maxHeight, buffer, validCells);
+}
+
+template<typename _Grid>
+void EquiRectWorldGenerator<_Grid>::generateChunks(const glm::ivec3 &chunkSize, size_t lod, GenerateChunkRequest *chunks, size_t count)
+{
+    //verify chunkSize matches template chunk size
+    assert(chunkSize==glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value));
+
+    if(count==0)
+        return;
+
+    //group chunks by column so each column's maps are only built once
+    std::vector<size_t> order(count);
+
+    for(size_t i=0; i<count; ++i)
+        order[i]=i;
+
+    std::stable_sort(order.begin(), order.end(), [chunks](size_t lhs, size_t rhs)
+    {
+        const glm::vec3 &lhsPos=chunks[lhs].startPos;
+        const glm::vec3 &rhsPos=chunks[rhs].startPos;
+
+        if(lhsPos.y!=rhsPos.y)
+            return lhsPos.y<rhsPos.y;
+        return lhsPos.x<rhsPos.x;
+    });
+
+    bool columnBuilt=false;
+    glm::vec2 column;
+
+    for(size_t i=0; i<count; ++i)
+    {
+        GenerateChunkRequest &chunk=chunks[order[i]];
+        glm::vec2 chunkColumn(chunk.startPos.x, chunk.startPos.y);
+
+        //column is only built if a chunk in it crosses the surface
+        if(m_classifyChunks && classifyChunk(chunk.startPos, chunkSize, lod, chunk.buffer, chunk.bufferSize, chunk.validCells))
+        {
+            chunk.uniform=true;
+            continue;
+        }
+
+        if(!columnBuilt || (chunkColumn!=column))
+        {
+            buildColumn(chunk.startPos, lod);
+            column=chunkColumn;
+            columnBuilt=true;
+        }
+
+        chunk.uniform=false;
+        chunk.validCells=fillChunk(chunk.startPos, chunk.buffer, chunk.bufferSize, lod, chunk.uniform);
+    }
+}
+
+//bound on the continent noise used for the column heights. 3D gradient noise is
+//sum(w_i*(g_i.d_i)) with edge gradients |g_i|=sqrt(2) and fade weights w_i summing to 1, so
+//|noise|<=sqrt(2)*sqrt(sum(w_i*|d_i|^2)) and the weighted distance is at most 0.25 per axis
+//(at the cell center), giving sqrt(1.5)~1.225. Fractal octaves are normalized by the fractal
+//bounding so do not raise it. ~10% margin over the bound for float error, buildColumn
+//asserts the noise stays inside
+const float ContinentNoiseBound=1.35f;
+
+template<typename _Grid>
+void EquiRectWorldGenerator<_Grid>::buildColumn(const glm::vec3 &startPos, size_t lod)
+{
     glm::ivec2 influenceIPos(startPos.x/m_descriptorValues.m_influenceGridSize.x, startPos.y/m_descriptorValues.m_influenceGridSize.y);
     size_t influenceIndex=((influenceIPos.y*m_descriptorValues.m_influenceSize.x)+influenceIPos.x);
     glm::vec2 influenceOffset=glm::vec2(startPos.x, startPos.y)-glm::vec2(influenceIPos*m_descriptorValues.m_influenceGridSize);
@@ -949,45 +1207,23 @@ unsigned int EquiRectWorldGenerator<_Grid>::generateChunk(const glm::vec3 &start
     influenceOffset=influenceOffset/influenceGridSize;
     glm::vec2 influenceBlockScale((float)ChunkType::sizeX::value/influenceGridSize.x, (float)ChunkType::sizeY::value/influenceGridSize.y);
     
-    InfluenceCell &influence=m_influenceMap[influenceIndex];
     float *neighborHeight=&m_influenceNeighborMap[influenceIndex*NeighborCount];
 
-//    UniqueChunkType chunk=std::make_unique<ChunkType>(hash, 0, chunkIndex, startPos);
-//    ChunkType::Cells &cells=chunk->getCells();
-    
-    typename ChunkType::CellType *cells=(typename ChunkType::CellType *)buffer;
     size_t stride=glm::pow(2u, (unsigned int)lod);
-    glm::ivec3 lodChunkSize=chunkSize/(int)stride;
-    float noiseScale=m_descriptorValues.m_noiseScale/stride;
 
-    //verify chunkSize matches template chunk size
-    assert(chunkSize==glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value));
-    //verify buffer is large enough for data
-    //assert(bufferSize>=(ChunkType::sizeX::value*ChunkType::sizeY::value*ChunkType::sizeZ::value)*sizeof(ChunkType::CellType));
-    assert(bufferSize>=(lodChunkSize.x*lodChunkSize.y*lodChunkSize.z)*sizeof(typename ChunkType::CellType));
+    m_threadStorage.column=getColumnHeightMap(startPos, lod);
 
-//    m_continentPerlin->FillNoiseSetMap(heightMap.data(), xMap.data(), yMap.data(), zMap.data(), lodChunkSize.x, lodChunkSize.y, 1);
-    buildHeightMap(startPos, lodChunkSize, stride);
-    if(m_threadStorage.blockHeightMap.size()!=m_threadStorage.heightMap.size())
-        m_threadStorage.blockHeightMap.resize(m_threadStorage.heightMap.size());
-    if(m_threadStorage.blockScaleMap.size()!=m_threadStorage.heightMap.size())
-        m_threadStorage.blockScaleMap.resize(m_threadStorage.heightMap.size());
+    const std::vector<float> &heightMap=m_threadStorage.column->heights;
 
-    int chunkMapSize=HastyNoise::AlignedSize(lodChunkSize.x*lodChunkSize.y*lodChunkSize.z, m_simdLevel);
-
-//    std::vector<float> layerMap(chunkMapSize);
-    m_threadStorage.layerMap.resize(chunkMapSize);
-
-//    m_layersPerlin->FillNoiseSet(layerMap.data(), offset.x, offset.y, offset.z, _Chunk::sizeX::value, _Chunk::sizeY::value, _Chunk::sizeZ::value);
+    if(m_threadStorage.surfaceHeights.size()!=heightMap.size())
+        m_threadStorage.surfaceHeights.resize(heightMap.size());
 
     glm::ivec3 &size=m_descriptors->m_size;
-    int seaLevel=(size.z/2);
 //    float heightScale=((float)size.z/2.0f);
     float heightScale=(float)size.z;
 
-//    float heightScale=1.0f-neighborHeight;
-    unsigned int validCells=0;
-    glm::ivec3 blockIndex;
+    int minHeight=std::numeric_limits<int>::max();
+    int maxHeight=std::numeric_limits<int>::min();
 
     size_t heightIndex=0;
     for(int y=0; y<ChunkType::sizeY::value; y+=stride)
@@ -1000,56 +1236,233 @@ unsigned int EquiRectWorldGenerator<_Grid>::generateChunk(const glm::vec3 &start
             float heightBase=bi_lerp(neighborHeight[0], neighborHeight[1], neighborHeight[2], neighborHeight[3], influencePos.x, influencePos.y);
             float influenceScale=abs(heightBase-0.5f)*scale;
 
-            m_threadStorage.blockHeightMap[heightIndex]=(heightBase-influenceScale)*heightScale;
-            m_threadStorage.blockScaleMap[heightIndex]=influenceScale*heightScale;
+            float blockHeightBase=(heightBase-influenceScale)*heightScale;
+            float blockScale=influenceScale*heightScale;
 //            blockHeight[heightIndex]=(int)(heightMap[heightIndex]*heightScale)+heightBase;
 
+            assert(std::abs(heightMap[heightIndex])<=ContinentNoiseBound);
+            int blockHeight=blockHeightBase+(heightMap[heightIndex]*blockScale);
+
+            m_threadStorage.surfaceHeights[heightIndex]=blockHeight;
+            minHeight=std::min(minHeight, blockHeight);
+            maxHeight=std::max(maxHeight, blockHeight);
             heightIndex++;
         }
     }
 
+    m_threadStorage.columnMinHeight=minHeight;
+    m_threadStorage.columnMaxHeight=maxHeight;
+}
+
+template<typename _Grid>
+SharedColumnHeightMap EquiRectWorldGenerator<_Grid>::getColumnHeightMap(const glm::vec3 &startPos, size_t lod)
+{
+    ColumnKey key((int)startPos.x, (int)startPos.y, lod);
+    SharedColumnHeightMap column=m_columnCache.find(key);
+
+    if(column)
+        return column;
+
+    size_t stride=glm::pow(2u, (unsigned int)lod);
+    glm::ivec3 lodChunkSize=glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)/(int)stride;
+    std::shared_ptr<ColumnHeightMap> newColumn=std::make_shared<ColumnHeightMap>();
+
+//    m_continentPerlin->FillNoiseSetMap(heightMap.data(), xMap.data(), yMap.data(), zMap.data(), lodChunkSize.x, lodChunkSize.y, 1);
+    buildHeightMap(startPos, lodChunkSize, stride, newColumn->heights);
+    m_columnCache.insert(key, newColumn);
+
+    return newColumn;
+}
+
+template<typename _Grid>
+void EquiRectWorldGenerator<_Grid>::getColumnHeightRange(const glm::vec3 &startPos, int &minHeight, int &maxHeight)
+{
+    glm::ivec2 influenceIPos(startPos.x/m_descriptorValues.m_influenceGridSize.x, startPos.y/m_descriptorValues.m_influenceGridSize.y);
+    size_t influenceIndex=((influenceIPos.y*m_descriptorValues.m_influenceSize.x)+influenceIPos.x);
+    glm::vec2 influenceOffset=glm::vec2(startPos.x, startPos.y)-glm::vec2(influenceIPos*m_descriptorValues.m_influenceGridSize);
+    glm::vec2 influenceGridSize(m_descriptorValues.m_influenceGridSize);
+
+    influenceOffset=influenceOffset/influenceGridSize;
+    glm::vec2 influenceBlockScale((float)ChunkType::sizeX::value/influenceGridSize.x, (float)ChunkType::sizeY::value/influenceGridSize.y);
+
+    float *neighborHeight=&m_influenceNeighborMap[influenceIndex*NeighborCount];
+
+    //blend weights buildColumn uses across the chunk, they run past 1 (bi_lerp extrapolates)
+    //on columns that reach past the influence cell
+    glm::vec2 weightMin=influenceOffset;
+    glm::vec2 weightMax=influenceOffset+(glm::vec2(ChunkType::sizeX::value-1, ChunkType::sizeY::value-1)*influenceBlockScale);
+
+    //the base height is bilinear in the weights, its extremes are at the corners of the weight range
+    std::array<float, 4> corners=
+    {
+        bi_lerp(neighborHeight[0], neighborHeight[1], neighborHeight[2], neighborHeight[3], weightMin.x, weightMin.y),
+        bi_lerp(neighborHeight[0], neighborHeight[1], neighborHeight[2], neighborHeight[3], weightMax.x, weightMin.y),
+        bi_lerp(neighborHeight[0], neighborHeight[1], neighborHeight[2], neighborHeight[3], weightMin.x, weightMax.y),
+        bi_lerp(neighborHeight[0], neighborHeight[1], neighborHeight[2], neighborHeight[3], weightMax.x, weightMax.y)
+    };
+    float baseMin=*std::min_element(corners.begin(), corners.end());
+    float baseMax=*std::max_element(corners.begin(), corners.end());
+
+    //buildColumn height is base-scale+(noise*scale) with scale=|base-0.5|/3, piecewise linear
+    //in base so the extremes are at the ends of the range or at 0.5
+    std::array<float, 3> bases={baseMin, baseMax, std::min(std::max(0.5f, baseMin), baseMax)};
+    float low=std::numeric_limits<float>::max();
+    float high=std::numeric_limits<float>::lowest();
+
+    for(float base:bases)
+    {
+        float scale=std::abs(base-0.5f)/3.0f;
+
+        low=std::min(low, base-scale-(ContinentNoiseBound*scale));
+        high=std::max(high, base-scale+(ContinentNoiseBound*scale));
+        //unscaled base covers the height when the scale is dropped
+        low=std::min(low, base);
+        high=std::max(high, base);
+    }
+
+    float heightScale=(float)m_descriptors->m_size.z;
+
+    //heights are truncated to int, a block either way covers it
+    minHeight=(int)std::floor(low*heightScale)-1;
+    maxHeight=(int)std::ceil(high*heightScale)+1;
+}
+
+template<typename _Grid>
+bool EquiRectWorldGenerator<_Grid>::uniformChunk(const glm::vec3 &startPos, size_t lod, int minHeight, int maxHeight, void *buffer, unsigned int &validCells)
+{
+    typename ChunkType::CellType *cells=(typename ChunkType::CellType *)buffer;
+    size_t stride=glm::pow(2u, (unsigned int)lod);
+    glm::ivec3 lodChunkSize=glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)/(int)stride;
+
+    int chunkBottom=(int)startPos.z;
+    int chunkTop=(int)startPos.z+ChunkType::sizeZ::value-(int)stride;
+
+    //chunk is above all the columns, all air
+    if(chunkBottom>maxHeight)
+    {
+        type(cells[0])=0;
+        validCells=0;
+        return true;
+    }
+
+    //chunk is below all the columns deep enough to be a single type
+    if(chunkTop<=minHeight-UniformBlockDepth)
+    {
+        unsigned int blockType=getBlockType<false>(chunkTop, minHeight-chunkTop, stride);
+
+        type(cells[0])=blockType;
+        validCells=(blockType!=0)?(lodChunkSize.x*lodChunkSize.y*lodChunkSize.z):0;
+        return true;
+    }
+
+    return false;
+}
+
+template<typename _Grid>
+unsigned int EquiRectWorldGenerator<_Grid>::fillChunk(const glm::vec3 &startPos, void *buffer, size_t bufferSize, size_t lod, bool &uniform)
+{
+    uniform=false;
+
+//    glm::vec3 offset=glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)*chunkIndex;
+
+//    UniqueChunkType chunk=std::make_unique<ChunkType>(hash, 0, chunkIndex, startPos);
+//    ChunkType::Cells &cells=chunk->getCells();
+    
+    typename ChunkType::CellType *cells=(typename ChunkType::CellType *)buffer;
+    size_t stride=glm::pow(2u, (unsigned int)lod);
+    glm::ivec3 lodChunkSize=glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)/(int)stride;
+
+    //verify buffer is large enough for data
+    //assert(bufferSize>=(ChunkType::sizeX::value*ChunkType::sizeY::value*ChunkType::sizeZ::value)*sizeof(ChunkType::CellType));
+    assert(bufferSize>=(lodChunkSize.x*lodChunkSize.y*lodChunkSize.z)*sizeof(typename ChunkType::CellType));
+
+    int chunkMapSize=HastyNoise::AlignedSize(lodChunkSize.x*lodChunkSize.y*lodChunkSize.z, m_simdLevel);
+
+//    std::vector<float> layerMap(chunkMapSize);
+    m_threadStorage.layerMap.resize(chunkMapSize);
+
+//    m_layersPerlin->FillNoiseSet(layerMap.data(), offset.x, offset.y, offset.z, _Chunk::sizeX::value, _Chunk::sizeY::value, _Chunk::sizeZ::value);
+
+//    float heightScale=1.0f-neighborHeight;
+    unsigned int validCells=0;
+    int minHeight=m_threadStorage.columnMinHeight;
+    int maxHeight=m_threadStorage.columnMaxHeight;
+
+    //exact column range, catches chunks the influence bound could not
+    if(uniformChunk(startPos, lod, minHeight, maxHeight, buffer, validCells))
+    {
+        uniform=true;
+        return validCells;
+    }
+
+    //cells for each layer, filled as runs so the whole cell is written with plain stores
+    std::array<typename ChunkType::CellType, ColumnLayerCount> layerCells;
+
+    for(size_t layer=0; layer<ColumnLayerCount; ++layer)
+    {
+        layerCells[layer]=typename ChunkType::CellType();
+        type(layerCells[layer])=columnLayerTypes[layer];
+    }
+
+    const std::vector<int> &surfaceHeights=m_threadStorage.surfaceHeights;
+    size_t sliceSize=lodChunkSize.x*lodChunkSize.y;
+    size_t chunkCells=sliceSize*lodChunkSize.z;
     size_t index=0;
-    heightIndex=0;
-    position.z=scaledOffset.z;
+
     for(int z=0; z<ChunkType::sizeZ::value; z+=stride)
     {
-        heightIndex=0;
-        position.y=scaledOffset.y;
-
         int blockZ=(int)startPos.z+z;
-        for(int y=0; y<ChunkType::sizeY::value; y+=stride)
+
+        //above every column, rest of the chunk is air
+        if(blockZ>maxHeight)
+        {
+            std::fill(cells+index, cells+chunkCells, layerCells[0]);
+            break;
+        }
+
+        //every column is in the same layer, fill the slice as one run
+        //(higher surface, same or lower layer)
+        size_t lowestLayer=columnLayer(blockZ, minHeight);
+        size_t highestLayer=columnLayer(blockZ, maxHeight);
+
+        if(lowestLayer==highestLayer)
         {
-            position.x=scaledOffset.x;
-            for(int x=0; x<ChunkType::sizeX::value; x+=stride)
+            std::fill(cells+index, cells+index+sliceSize, layerCells[lowestLayer]);
+            if(lowestLayer!=0)
+                validCells+=sliceSize;
+            index+=sliceSize;
+            continue;
+        }
+
+        //runs of the same layer along each row
+        size_t heightIndex=0;
+
+        for(int y=0; y<lodChunkSize.y; ++y)
+        {
+            size_t runStart=index;
+            size_t runLayer=columnLayer(blockZ, surfaceHeights[heightIndex]);
+
+            for(int x=0; x<lodChunkSize.x; ++x)
             {
-                unsigned int blockType;
-                int blockHeight=m_threadStorage.blockHeightMap[heightIndex]+(m_threadStorage.heightMap[heightIndex]*m_threadStorage.blockScaleMap[heightIndex]);// (int)(heightMap[heightIndex]*heightScale)+seaLevel;
+                size_t layer=columnLayer(blockZ, surfaceHeights[heightIndex]);
 
-//                if(position.z > heightMap[heightIndex]) //larger than height map, air
-                if(blockZ>blockHeight)
-                    blockType=0;
-                else
+                if(layer!=runLayer)
                 {
-                    if(stride == 1)
-                        blockType=getBlockType<false>(blockZ, blockHeight-blockZ, stride);
-                    else
-                        blockType=getBlockType<true>(blockZ, blockHeight-blockZ, stride);
-
-//                    if(blockZ<seaLevel)
-//                        blockType=1;
-//                    blockType=(blockHeight-blockZ)/13+2;
-                    if(blockType!=0)
-                        validCells++;
-                }
+                    std::fill(cells+runStart, cells+index, layerCells[runLayer]);
+                    if(runLayer!=0)
+                        validCells+=index-runStart;
 
-                type(cells[index])=blockType;
+                    runStart=index;
+                    runLayer=layer;
+                }
                 index++;
                 heightIndex++;
-                position.x+=noiseScale;
             }
-            position.y+=noiseScale;
+
+            std::fill(cells+runStart, cells+index, layerCells[runLayer]);
+            if(runLayer!=0)
+                validCells+=index-runStart;
         }
-        position.z+=noiseScale;
     }
 
     return validCells;
@@ -1072,7 +1485,6 @@ unsigned int EquiRectWorldGenerator<_Grid>::generateRegion(const glm::vec3 &star
     int heightMapSize=HastyNoise::AlignedSize(lodSize.x*lodSize.y, m_simdLevel);
 
     m_threadStorage.regionHeightMap.resize(heightMapSize);
-    m_threadStorage.regionVectorSet->SetSize(heightMapSize);
 
     size_t index=0;
     glm::vec3 mapPos;
@@ -1081,24 +1493,52 @@ unsigned int EquiRectWorldGenerator<_Grid>::generateRegion(const glm::vec3 &star
     int seaLevel=(size.z/2);
     unsigned int validCells=0;
 
-    mapPos.z=(float)size.x/2.0f;
-    for(int y=0; y<regionSize.y; y+=stride)
+    if((stride<=ChunkType::sizeX::value)&&(stride<=ChunkType::sizeY::value))
     {
-        mapPos.y=startPos.y+y;
-        for(int x=0; x<regionSize.x; x+=stride)
-        {
-            mapPos.x=startPos.x+x;
+        //samples line up with the chunk columns, build from the column cache so
+        //region and chunk generation share the continent noise
+        glm::ivec2 columnLodSize(ChunkType::sizeX::value/stride, ChunkType::sizeY::value/stride);
 
-            glm::vec3 pos=getCylindricalCoords(size.x, size.y, mapPos);
+        for(int y=0; y<regionSize.y; y+=ChunkType::sizeY::value)
+        {
+            for(int x=0; x<regionSize.x; x+=ChunkType::sizeX::value)
+            {
+                SharedColumnHeightMap column=getColumnHeightMap(glm::vec3(startPos.x+x, startPos.y+y, startPos.z), lod);
+                const float *heights=column->heights.data();
+                float *regionHeights=&m_threadStorage.regionHeightMap[((y/stride)*lodSize.x)+(x/stride)];
 
-            m_threadStorage.regionVectorSet->xSet[index]=pos.x;
-            m_threadStorage.regionVectorSet->ySet[index]=pos.y;
-            m_threadStorage.regionVectorSet->zSet[index]=pos.z;
-            index++;
+                for(int columnY=0; columnY<columnLodSize.y; ++columnY)
+                {
+                    std::copy(heights, heights+columnLodSize.x, regionHeights);
+                    heights+=columnLodSize.x;
+                    regionHeights+=lodSize.x;
+                }
+            }
         }
     }
+    else
+    {
+        m_threadStorage.regionVectorSet->SetSize(heightMapSize);
+
+        mapPos.z=(float)size.x/2.0f;
+        for(int y=0; y<regionSize.y; y+=stride)
+        {
+            mapPos.y=startPos.y+y;
+            for(int x=0; x<regionSize.x; x+=stride)
+            {
+                mapPos.x=startPos.x+x;
+
+                glm::vec3 pos=getCylindricalCoords(size.x, size.y, mapPos);
 
-    m_continentPerlin->FillSet(m_threadStorage.regionHeightMap.data(), m_threadStorage.regionVectorSet.get());
+                m_threadStorage.regionVectorSet->xSet[index]=pos.x;
+                m_threadStorage.regionVectorSet->ySet[index]=pos.y;
+                m_threadStorage.regionVectorSet->zSet[index]=pos.z;
+                index++;
+            }
+        }
+
+        m_continentPerlin->FillSet(m_threadStorage.regionHeightMap.data(), m_threadStorage.regionVectorSet.get());
+    }
 
     index=0;
     for(int y=0; y<regionSize.y; y+=stride)
@@ -1201,11 +1641,14 @@ int EquiRectWorldGenerator<_Grid>::getBaseHeight(const glm::vec2 &pos)
 //}
 
 template<typename _Grid>
-void EquiRectWorldGenerator<_Grid>::buildHeightMap(const glm::vec3 &startPos, const glm::ivec3 &lodSize, size_t stride)
+void EquiRectWorldGenerator<_Grid>::buildHeightMap(const glm::vec3 &startPos, const glm::ivec3 &lodSize, size_t stride, std::vector<float> &heightMap)
 {
+    if(!m_threadStorage.vectorSet)
+        m_threadStorage.vectorSet=std::make_unique<HastyNoise::VectorSet>(m_simdLevel);
+
     int heightMapSize=HastyNoise::AlignedSize(lodSize.x*lodSize.y, m_simdLevel);
 
-    m_threadStorage.heightMap.resize(heightMapSize);
+    heightMap.resize(heightMapSize);
     m_threadStorage.xMap.resize(heightMapSize);
     m_threadStorage.yMap.resize(heightMapSize);
     m_threadStorage.zMap.resize(heightMapSize);
@@ -1234,7 +1677,7 @@ void EquiRectWorldGenerator<_Grid>::buildHeightMap(const glm::vec3 &startPos, co
         }
     }
 
-    m_continentPerlin->FillSet(m_threadStorage.heightMap.data(), m_threadStorage.vectorSet.get());
+    m_continentPerlin->FillSet(heightMap.data(), m_threadStorage.vectorSet.get());
 //    m_continentPerlin->FillNoiseSetMap(heightMap.data(), xMap.data(), yMap.data(), zMap.data(), lodSize.x, lodSize.y, 1);
 }
 
@@ -1244,39 +1687,29 @@ void EquiRectWorldGenerator<_Grid>::buildHeightMap(const glm::vec3 &startPos, co
 //
 //}
 
-inline float lerp(float v0, float v1, float t)
-{
-    return (1-t)*v0+t*v1;
-}
-
-inline float bi_lerp(float v00, float v10, float v01, float v11, float t0, float t1)
-{
-    return lerp(lerp(v00, v10, t0), lerp(v01, v11, t0), t1);
-}
-
 template<typename _Grid>
 void EquiRectWorldGenerator<_Grid>::updateInfluenceNeighbors()
 {
-    if(m_influenceNeighborMap.size()/NeighborCount!= m_influenceMap.size())
+    //mapped neighbor heights are read only
+    if(m_influenceNeighborMap.isMapped()||(m_influenceNeighborMap.size()/NeighborCount!= m_influenceMap.size()))
         m_influenceNeighborMap.resize(m_influenceMap.size()*NeighborCount);
 
     glm::ivec2 influenceSize=m_descriptorValues.m_influenceSize;
-    glm::ivec2 influencePos(0, 0);
-    size_t index=0;
 
-    for(influencePos.y=0; influencePos.y<influenceSize.y; ++influencePos.y)
+    parallelFor(m_influenceMap.size(), OverviewBlockSize, [&](size_t block, size_t begin, size_t end)
     {
-        influencePos.x=0;
-        for(influencePos.x=0; influencePos.x<influenceSize.x; ++influencePos.x)
+        for(size_t cell=begin; cell<end; ++cell)
         {
+            glm::ivec2 influencePos((int)(cell%influenceSize.x), (int)(cell/influenceSize.x));
             std::vector<size_t> neighborIndexes=get2DCellNeighbors_eq(influencePos, influenceSize);
 
+            const float *heightBase=m_influenceMap.heightBase.data();
             float neighborHeight[9];
-            float *neighborHeightMap=&m_influenceNeighborMap[index];
+            float *neighborHeightMap=&m_influenceNeighborMap[cell*NeighborCount];
             
             for(size_t i=0; i<9; ++i)
             {
-                neighborHeight[i]=m_influenceMap[neighborIndexes[i]].heightBase;
+                neighborHeight[i]=heightBase[neighborIndexes[i]];
             }
 
             //TODO: could be replaced with (neighborHeight[0]+neighborHeight[1]+neighborHeight[3]+neighborHeight[4])*0.25f
@@ -1284,11 +1717,8 @@ void EquiRectWorldGenerator<_Grid>::updateInfluenceNeighbors()
             neighborHeightMap[1]=bi_lerp(neighborHeight[1], neighborHeight[2], neighborHeight[4], neighborHeight[5], 0.5f, 0.5f);
             neighborHeightMap[2]=bi_lerp(neighborHeight[3], neighborHeight[4], neighborHeight[6], neighborHeight[7], 0.5f, 0.5f);
             neighborHeightMap[3]=bi_lerp(neighborHeight[4], neighborHeight[5], neighborHeight[7], neighborHeight[8], 0.5f, 0.5f);
-
-            index+=NeighborCount;
         }
-    }
-
+    }, m_overviewThreads);
 }
 
 }//namespace voxigen
@@ -18,6 +18,20 @@ namespace voxigen
 template<typename _Chunk>
 class ChunkHandle;
 
+//single chunk of a generateChunks batch
+struct GenerateChunkRequest
+{
+    GenerateChunkRequest():buffer(nullptr), bufferSize(0), validCells(0), uniform(false) {}
+    GenerateChunkRequest(const glm::vec3 &startPos, void *buffer, size_t bufferSize):startPos(startPos), buffer(buffer), bufferSize(bufferSize), validCells(0), uniform(false) {}
+
+    glm::vec3 startPos;
+    void *buffer;
+    size_t bufferSize;
+
+    unsigned int validCells;//out, same as generateChunk return
+    bool uniform;           //out
+};
+
 class Generator
 {
 public:
@@ -33,7 +47,15 @@ public:
     //    virtual void terminate()=0;
 
     //    virtual void generateChunk(unsigned int hash, void *buffer, size_t size)=0;
-    virtual unsigned int generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod)=0;
+    //returns number of non empty cells, if every cell is the same type only the first cell 
+    //in buffer is written and uniform is set
+    virtual unsigned int generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod, bool &uniform)=0;
+    //generates a batch of chunks at the same lod (ie a column), 2d work (height/influence) is
+    //done once per x,y column and shared by every chunk in that column
+    virtual void generateChunks(const glm::ivec3 &chunkSize, size_t lod, GenerateChunkRequest *chunks, size_t count)=0;
+    //cheap check for chunks that are a single cell type (ie all air or all solid), only the first
+    //cell in buffer is written. Returns false if the chunk has to be generated
+    virtual bool classifyChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, size_t lod, void *buffer, size_t bufferSize, unsigned int &validCells) { return false; }
     virtual unsigned int generateRegion(const glm::vec3 &startPos, const glm::ivec3 &size, void *buffer, size_t bufferSize, size_t lod)=0;
 
     //used to get the general height at a location, may not be exact
@@ -62,7 +84,9 @@ public:
     //    void terminate() { m_generator->terminate(); }
 
     //    void generateChunk(unsigned int hash, void *buffer, size_t size) { m_generator->generateChunk(hash, buffer, size); };
-    unsigned int generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod) override { return m_generator->generateChunk(startPos, chunkSize, buffer, bufferSize, lod); };
+    unsigned int generateChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, void *buffer, size_t bufferSize, size_t lod, bool &uniform) override { return m_generator->generateChunk(startPos, chunkSize, buffer, bufferSize, lod, uniform); };
+    void generateChunks(const glm::ivec3 &chunkSize, size_t lod, GenerateChunkRequest *chunks, size_t count) override { m_generator->generateChunks(chunkSize, lod, chunks, count); };
+    bool classifyChunk(const glm::vec3 &startPos, const glm::ivec3 &chunkSize, size_t lod, void *buffer, size_t bufferSize, unsigned int &validCells) override { return m_generator->classifyChunk(startPos, chunkSize, lod, buffer, bufferSize, validCells); };
     unsigned int generateRegion(const glm::vec3 &startPos, const glm::ivec3 &size, void *buffer, size_t bufferSize, size_t lod) override { return m_generator->generateRegion(startPos, size, buffer, bufferSize, lod); };
 
     int getBaseHeight(const glm::vec2 &pos) override { return m_generator->getBaseHeight(pos); };
@@ -0,0 +1,195 @@
+#ifndef _voxigen_influenceMap_h_
+#define _voxigen_influenceMap_h_
+
+#include "voxigen/alignedAllocator.h"
+#include "voxigen/fileio/mappedFile.h"
+#include "voxigen/generators/tectonics.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+namespace voxigen
+{
+
+constexpr size_t InfluenceMap_Alignment=64;
+
+template<typename _Type>
+using InfluenceArray=std::vector<_Type, AlignedAllocator<_Type, InfluenceMap_Alignment>>;
+
+inline size_t alignInfluenceOffset(size_t offset) { return (offset+InfluenceMap_Alignment-1)&~(InfluenceMap_Alignment-1); }
+
+//single influence field, either owns its aligned array or views an array inside a mapped
+//file (kept alive by the field). Mapped views are read only, resize() goes back to an owned array
+template<typename _Type>
+class InfluenceField
+{
+public:
+    typedef _Type value_type;
+
+    InfluenceField():m_data(nullptr), m_size(0) {}
+
+    InfluenceField(const InfluenceField &)=delete;
+    InfluenceField &operator=(const InfluenceField &)=delete;
+
+    _Type &operator[](size_t index) { return m_data[index]; }
+    const _Type &operator[](size_t index) const { return m_data[index]; }
+
+    _Type *data() { return m_data; }
+    const _Type *data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size==0; }
+
+    bool isMapped() const { return (bool)m_mapping; }
+
+    void resize(size_t size)
+    {
+        m_mapping.reset();
+        m_array.assign(size, _Type());
+        m_data=m_array.data();
+        m_size=size;
+    }
+
+    //copies a mapped view into an owned array, the file can then be rewritten
+    void unmap()
+    {
+        if(!m_mapping)
+            return;
+
+        m_array.assign(m_data, m_data+m_size);
+        m_data=m_array.data();
+        m_mapping.reset();
+    }
+
+    void view(const _Type *data, size_t size, SharedMappedFile mapping)
+    {
+        InfluenceArray<_Type>().swap(m_array);
+        m_mapping=mapping;
+        m_data=const_cast<_Type *>(data);
+        m_size=size;
+    }
+
+private:
+    InfluenceArray<_Type> m_array;
+    SharedMappedFile m_mapping;
+
+    _Type *m_data;
+    size_t m_size;
+};
+
+//plate and weather ids, plate count is limited by EquiRectDescriptors::m_plateCountMax
+typedef uint16_t InfluenceIndex;
+
+//influence map stored as one aligned array per field (struct of arrays), passes only touch
+//the fields they use. operator[] builds an InfluenceCell copy for the debug views. The
+//arrays can be views into a mapped overview file (see EquiRectWorldGenerator::loadWorldOverview)
+class InfluenceMap
+{
+public:
+    size_t size() const { return heightBase.size(); }
+    bool empty() const { return heightBase.empty(); }
+
+    void resize(size_t size)
+    {
+        forEachArray([size](auto &array) { array.resize(size); });
+    }
+
+    bool isMapped() const { return heightBase.isMapped(); }
+    void unmap() { forEachArray([](auto &array) { array.unmap(); }); }
+
+    InfluenceCell operator[](size_t index) const { return cell(index); }
+
+    InfluenceCell cell(size_t index) const
+    {
+        InfluenceCell cell;
+
+        cell.point=(point[index]!=0);
+        cell.heightBase=heightBase[index];
+        cell.heightRange=heightRange[index];
+        cell.tectonicPlate=tectonicPlate[index];
+        cell.borderPlate=borderPlate[index];
+        cell.plateHeight=plateHeight[index];
+        cell.plateValue=plateValue[index];
+        cell.plateDistanceValue=plateDistanceValue[index];
+        cell.plateDistanceValueNorm=plateDistanceValueNorm[index];
+        cell.continentValue=continentValue[index];
+        cell.collision=collision[index];
+        cell.terrainScale=terrainScale[index];
+        cell.weatherCell=weatherCell[index];
+        cell.weatherBand=weatherBand[index];
+        cell.direction=direction[index];
+        cell.airDirection=airDirection[index];
+        cell.airCurrent=airCurrent[index];
+        cell.temperature=temperature[index];
+        cell.moistureCapacity=moistureCapacity[index];
+        cell.moisture=moisture[index];
+        return cell;
+    }
+
+    //calls function(array) for every field array, always in the same order
+    template<typename _Function>
+    void forEachArray(_Function function)
+    {
+        function(point);
+        function(heightBase);
+        function(heightRange);
+        function(tectonicPlate);
+        function(borderPlate);
+        function(plateHeight);
+        function(plateValue);
+        function(plateDistanceValue);
+        function(plateDistanceValueNorm);
+        function(continentValue);
+        function(collision);
+        function(terrainScale);
+        function(weatherCell);
+        function(weatherBand);
+        function(direction);
+        function(airDirection);
+        function(airCurrent);
+        function(temperature);
+        function(moistureCapacity);
+        function(moisture);
+    }
+
+    //bytes used by a single cell across all the arrays
+    size_t cellSize()
+    {
+        size_t bytes=0;
+
+        forEachArray([&bytes](auto &array) { bytes+=sizeof(typename std::decay<decltype(array)>::type::value_type); });
+        return bytes;
+    }
+
+    InfluenceField<uint8_t> point;
+    InfluenceField<float> heightBase;
+    InfluenceField<float> heightRange;
+
+    InfluenceField<InfluenceIndex> tectonicPlate;
+    InfluenceField<InfluenceIndex> borderPlate;
+    InfluenceField<float> plateHeight;
+    InfluenceField<float> plateValue;
+    InfluenceField<float> plateDistanceValue;
+    InfluenceField<float> plateDistanceValueNorm;
+    InfluenceField<float> continentValue;
+
+    InfluenceField<float> collision;
+    InfluenceField<float> terrainScale;
+
+    InfluenceField<InfluenceIndex> weatherCell;
+    InfluenceField<InfluenceIndex> weatherBand;
+
+    InfluenceField<glm::vec2> direction;
+    InfluenceField<glm::vec2> airDirection;
+    InfluenceField<float> airCurrent;
+
+    InfluenceField<float> temperature;
+    InfluenceField<float> moistureCapacity;
+    InfluenceField<float> moisture;
+};
+
+}//namespace voxigen
+
+#endif //_voxigen_influenceMap_h_
@@ -3,6 +3,11 @@
 
 #include "voxigen/voxigen_export.h"
 
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cmath>
+
 namespace voxigen
 {
 
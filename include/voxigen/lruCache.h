@@ -0,0 +1,178 @@
+#ifndef _voxigen_lruCache_h_
+#define _voxigen_lruCache_h_
+
+#include <memory>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+namespace voxigen
+{
+
+//every entry counts 1 against the capacity
+template<typename _Value>
+struct LruEntryCount
+{
+    size_t operator()(const _Value &value) const { return 1; }
+};
+
+//Bounded LRU shared by worker threads. Entries are immutable once inserted, callers hold
+//a shared pointer so eviction is safe. _Cost gives what an entry counts against the capacity
+template<typename _Key, typename _Value, typename _Hash, typename _Cost=LruEntryCount<_Value>>
+class LruCache
+{
+public:
+    typedef std::shared_ptr<const _Value> SharedValue;
+
+    LruCache(size_t capacity):m_capacity(capacity), m_used(0), m_hits(0), m_misses(0), m_evictions(0) {}
+
+    void setCapacity(size_t capacity);
+    size_t capacity() const { return m_capacity; }
+    size_t used() const;
+    size_t size() const;
+
+    //returns null on miss
+    SharedValue find(const _Key &key);
+    void insert(const _Key &key, SharedValue value);
+    void clear();
+
+    size_t hits() const { return m_hits.load(); }
+    size_t misses() const { return m_misses.load(); }
+    size_t evictions() const { return m_evictions.load(); }
+    void resetCounters();
+
+private:
+    struct Entry
+    {
+        Entry(const _Key &key, SharedValue value, size_t cost):key(key), value(value), cost(cost) {}
+
+        _Key key;
+        SharedValue value;
+        size_t cost;
+    };
+    typedef std::list<Entry> EntryList;
+    typedef std::unordered_map<_Key, typename EntryList::iterator, _Hash> EntryMap;
+
+    void evict();
+
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    size_t m_used;
+    EntryList m_entries; //most recently used at front
+    EntryMap m_entryMap;
+
+    std::atomic<size_t> m_hits;
+    std::atomic<size_t> m_misses;
+    std::atomic<size_t> m_evictions;
+};
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+void LruCache<_Key, _Value, _Hash, _Cost>::setCapacity(size_t capacity)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_capacity=capacity;
+    evict();
+}
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+size_t LruCache<_Key, _Value, _Hash, _Cost>::used() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_used;
+}
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+size_t LruCache<_Key, _Value, _Hash, _Cost>::size() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_entryMap.size();
+}
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+typename LruCache<_Key, _Value, _Hash, _Cost>::SharedValue LruCache<_Key, _Value, _Hash, _Cost>::find(const _Key &key)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto iter=m_entryMap.find(key);
+
+    if(iter==m_entryMap.end())
+    {
+        m_misses++;
+        return SharedValue();
+    }
+
+    //move to front
+    m_entries.splice(m_entries.begin(), m_entries, iter->second);
+    m_hits++;
+    return iter->second->value;
+}
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+void LruCache<_Key, _Value, _Hash, _Cost>::insert(const _Key &key, SharedValue value)
+{
+    size_t cost=_Cost()(*value);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(cost>m_capacity)
+        return;
+
+    auto iter=m_entryMap.find(key);
+
+    //another thread may have built the same entry, keep the latest
+    if(iter!=m_entryMap.end())
+    {
+        Entry &entry=*iter->second;
+
+        m_used-=entry.cost;
+        entry.value=value;
+        entry.cost=cost;
+        m_entries.splice(m_entries.begin(), m_entries, iter->second);
+    }
+    else
+    {
+        m_entries.emplace_front(key, value, cost);
+        m_entryMap.insert({key, m_entries.begin()});
+    }
+
+    m_used+=cost;
+    evict();
+}
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+void LruCache<_Key, _Value, _Hash, _Cost>::clear()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_entries.clear();
+    m_entryMap.clear();
+    m_used=0;
+}
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+void LruCache<_Key, _Value, _Hash, _Cost>::resetCounters()
+{
+    m_hits=0;
+    m_misses=0;
+    m_evictions=0;
+}
+
+template<typename _Key, typename _Value, typename _Hash, typename _Cost>
+void LruCache<_Key, _Value, _Hash, _Cost>::evict()
+{
+    while(m_used>m_capacity)
+    {
+        m_used-=m_entries.back().cost;
+        m_entryMap.erase(m_entries.back().key);
+        m_entries.pop_back();
+        m_evictions++;
+    }
+}
+
+}//namespace voxigen
+
+#endif //_voxigen_lruCache_h_
@@ -0,0 +1,203 @@
+#ifndef _voxigen_bitmaskMeshBuilder_h_
+#define _voxigen_bitmaskMeshBuilder_h_
+
+#include "voxigen/defines.h"
+#include "voxigen/volume/chunk.h"
+#include "voxigen/meshes/faces.h"
+#include "voxigen/meshbuilders/cubicMeshBuilder.h"
+
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace voxigen
+{
+
+namespace bitmask
+{
+
+inline size_t lowestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+
+    _BitScanForward64(&index, value);
+    return index;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+//adds a face for every set bit in faceBits, bits run along axis
+template<typename _Chunk, typename _ChunkMesh>
+void addFaces(_ChunkMesh &mesh, const typename _Chunk::CellViewType &cells, size_t face, uint64_t faceBits, glm::ivec3 &position, size_t axis, size_t axisPitch, size_t index, size_t stride)
+{
+    while(faceBits!=0)
+    {
+        size_t bit=lowestBit(faceBits);
+
+        faceBits&=faceBits-1;
+        position[axis]=(int)bit;
+
+        unsigned int cellType=type(cells[index+(bit*axisPitch)]);
+
+        addFace<_Chunk, _ChunkMesh>(mesh, face, position, cellType, stride);
+    }
+}
+
+//occupancy of the neighbor cells touching the chunk, borders[face] is indexed as the
+//columns of the face's axis are. A solid -axis neighbor cell sets bit 0 and a solid +axis
+//one bit size-1, where the shifted column would have them. Missing neighbors (or a
+//different lod) leave the bits clear so those faces are added
+template<typename _Chunk>
+void gatherBorders(_Chunk *chunk, const glm::ivec3 &size, std::array<std::vector<uint64_t>, 6> &borders)
+{
+    std::vector<_Chunk *> &neighbors=chunk->getNeighbors();
+
+    for(size_t face=0; face<6; ++face)
+    {
+        _Chunk *neighbor=neighbors[face];
+
+        if(!neighbor||(neighbor->getLod()!=chunk->getLod()))
+            continue;
+
+        size_t axis=face/2;
+        size_t axisU=(axis+1)%3;
+        size_t axisV=(axis+2)%3;
+        bool positive=(face&1)!=0;
+        uint64_t bit=positive?uint64_t(1)<<(size[axis]-1):uint64_t(1);
+        std::vector<uint64_t> &faceBorders=borders[face];
+
+        if(neighbor->isUniform())
+        {
+            if(empty(neighbor->getUniformCell()))
+                continue;
+
+            std::fill(faceBorders.begin(), faceBorders.end(), bit);
+            continue;
+        }
+
+        typename _Chunk::CellViewType neighborCells=neighbor->getCellView();
+        glm::ivec3 neighborPos;
+        size_t columnIndex=0;
+
+        neighborPos[axis]=positive?0:size[axis]-1;
+        for(int v=0; v<size[axisV]; ++v)
+        {
+            neighborPos[axisV]=v;
+            for(int u=0; u<size[axisU]; ++u, ++columnIndex)
+            {
+                neighborPos[axisU]=u;
+
+                size_t neighborIndex=(neighborPos.z*size.x*size.y)+(neighborPos.y*size.x)+neighborPos.x;
+
+                if(!empty(neighborCells[neighborIndex]))
+                    faceBorders[columnIndex]=bit;
+            }
+        }
+    }
+}
+
+}//namespace bitmask
+
+//builds 64 bit occupancy columns along each axis, visible faces are the solid bits
+//with an empty bit next to them (col&~(col<<1) for -axis, col&~(col>>1) for +axis),
+//faces on the chunk boundary are added unless an attached neighbor (Chunk::setNeighbor)
+//has a solid cell against them
+template<typename _Chunk, typename _ChunkMesh>
+void buildBitmaskMesh(_ChunkMesh &mesh, _Chunk *chunk)
+{
+    static_assert((_Chunk::sizeX::value<=64)&&(_Chunk::sizeY::value<=64)&&(_Chunk::sizeZ::value<=64), "bitmask mesher requires chunk dimensions of 64 or less");
+
+    size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
+    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
+    glm::ivec3 pitch(1, size.x, size.x*size.y);
+
+    if(chunk->isUniform())
+    {
+        buildUniformMesh(mesh, chunk, stride, chunk->hasNeighbors()?&chunk->getNeighbors():nullptr);
+        return;
+    }
+
+    typename _Chunk::CellViewType cells=chunk->getCellView();
+
+    //columns[axis] indexed by (v*sizeU)+u, u/v being the next two axis
+    static thread_local std::array<std::vector<uint64_t>, 3> columns;
+    static thread_local std::array<std::vector<uint64_t>, 6> borders;
+
+    columns[0].assign(size.y*size.z, 0);
+    columns[1].assign(size.z*size.x, 0);
+    columns[2].assign(size.x*size.y, 0);
+
+    for(size_t face=0; face<6; ++face)
+        borders[face].assign(columns[face/2].size(), 0);
+
+    if(chunk->hasNeighbors())
+        bitmask::gatherBorders(chunk, size, borders);
+
+    size_t index=0;
+
+    for(int z=0; z<size.z; ++z)
+    {
+        uint64_t zBit=uint64_t(1)<<z;
+
+        for(int y=0; y<size.y; ++y)
+        {
+            uint64_t yBit=uint64_t(1)<<y;
+            uint64_t xColumn=0;
+
+            for(int x=0; x<size.x; ++x)
+            {
+                if(!empty(cells[index++]))
+                {
+                    xColumn|=uint64_t(1)<<x;
+                    columns[1][(x*size.z)+z]|=yBit;
+                    columns[2][(y*size.x)+x]|=zBit;
+                }
+            }
+            columns[0][(z*size.y)+y]=xColumn;
+        }
+    }
+
+    for(size_t axis=0; axis<3; ++axis)
+    {
+        size_t axisU=(axis+1)%3;
+        size_t axisV=(axis+2)%3;
+        const std::vector<uint64_t> &axisColumns=columns[axis];
+        const std::vector<uint64_t> &negBorders=borders[axis*2];
+        const std::vector<uint64_t> &posBorders=borders[(axis*2)+1];
+        size_t columnIndex=0;
+        glm::ivec3 position;
+
+        for(int v=0; v<size[axisV]; ++v)
+        {
+            position[axisV]=v;
+            for(int u=0; u<size[axisU]; ++u)
+            {
+                size_t borderIndex=columnIndex++;
+                uint64_t column=axisColumns[borderIndex];
+
+                if(column==0)
+                    continue;
+
+                position[axisU]=u;
+
+                size_t baseIndex=(position[axisU]*pitch[axisU])+(position[axisV]*pitch[axisV]);
+                uint64_t negFaces=column&~((column<<1)|negBorders[borderIndex]);
+                uint64_t posFaces=column&~((column>>1)|posBorders[borderIndex]);
+
+                bitmask::addFaces<_Chunk, _ChunkMesh>(mesh, cells, axis*2, negFaces, position, axis, pitch[axis], baseIndex, stride);
+                bitmask::addFaces<_Chunk, _ChunkMesh>(mesh, cells, (axis*2)+1, posFaces, position, axis, pitch[axis], baseIndex, stride);
+            }
+        }
+    }
+}
+
+} //namespace voxigen
+
+#endif //_voxigen_bitmaskMeshBuilder_h_
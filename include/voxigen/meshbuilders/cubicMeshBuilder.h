@@ -342,9 +342,9 @@ void addFace(_ChunkMesh &mesh, size_t face, const glm::ivec3 &position, unsigned
 }
 
 template<typename _Chunk, typename _ChunkMesh, bool _XNegFace=true, bool _XPosFace=true, bool _YNegFace=true, bool _YPosFace=true, bool _ZNegFace=true, bool _ZPosFace=true>
-void checkCell(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, glm::ivec3 &position, size_t stride)
+void checkCell(_ChunkMesh &mesh, const typename _Chunk::CellViewType &cells, size_t &index, glm::ivec3 &position, size_t stride)
 {
-    typename _Chunk::CellType &cell=cells[index];
+    const typename _Chunk::CellType &cell=cells[index];
 
     if(empty(cell))
         return;
@@ -415,7 +415,7 @@ void checkCell(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, g
 }
 
 template<typename _Chunk, typename _ChunkMesh, bool _YNegFace=true, bool _YPosFace=true, bool _ZNegFace=true, bool _ZPosFace=true>
-void checkX(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, glm::ivec3 &position, size_t stride)
+void checkX(_ChunkMesh &mesh, const typename _Chunk::CellViewType &cells, size_t &index, glm::ivec3 &position, size_t stride)
 {
     position.x=0;
 
@@ -435,7 +435,7 @@ void checkX(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, glm:
 }
 
 template<typename _Chunk, typename _ChunkMesh, bool _ZNegFace=true, bool _ZPosFace=true>
-void checkY(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, glm::ivec3 &position, size_t stride)
+void checkY(_ChunkMesh &mesh, const typename _Chunk::CellViewType &cells, size_t &index, glm::ivec3 &position, size_t stride)
 {
     position.y=0;
 
@@ -453,17 +453,90 @@ void checkY(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, glm:
     checkX<_Chunk, _ChunkMesh, true, false, _ZNegFace, _ZPosFace>(mesh, cells, index, position, stride);
 }
 
+//uniform chunk only has faces on its boundary, a face side is skipped if the neighbor on 
+//that side is uniform and solid, otherwise the neighbors cells are checked (if provided)
+//neighbors vector follows the faces indexing, 0:-x, 1:+x, 2:-y, 3:+y, 4:-z, 5:+z
+template<typename _Chunk, typename _ChunkMesh>
+void buildUniformMesh(_ChunkMesh &mesh, _Chunk *chunk, size_t stride, std::vector<_Chunk *> *neighbors=nullptr)
+{
+    const typename _Chunk::CellType &cell=chunk->getUniformCell();
+
+    if(empty(cell))
+        return;
+
+    unsigned int cellType=type(cell);
+    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
+
+    for(size_t face=0; face<6; ++face)
+    {
+        _Chunk *neighbor=nullptr;
+
+        if(neighbors&&(face<neighbors->size()))
+        {
+            neighbor=(*neighbors)[face];
+
+            //different lod, cells do not line up
+            if(neighbor&&(neighbor->getLod()!=chunk->getLod()))
+                neighbor=nullptr;
+        }
+
+        if(neighbor&&neighbor->isUniform()&&!empty(neighbor->getUniformCell()))
+            continue;
+
+        bool checkNeighbor=neighbor&&!neighbor->isUniform();
+        typename _Chunk::CellViewType neighborCells;
+
+        if(checkNeighbor)
+            neighborCells=neighbor->getCellView();
+
+        size_t axis=face/2;
+        size_t axisU=(axis+1)%3;
+        size_t axisV=(axis+2)%3;
+        bool positive=(face&1)!=0;
+        glm::ivec3 position;
+        glm::ivec3 neighborPos;
+
+        position[axis]=positive?size[axis]-1:0;
+        neighborPos[axis]=positive?0:size[axis]-1;
+
+        for(int v=0; v<size[axisV]; ++v)
+        {
+            position[axisV]=v;
+            neighborPos[axisV]=v;
+
+            for(int u=0; u<size[axisU]; ++u)
+            {
+                position[axisU]=u;
+
+                if(checkNeighbor)
+                {
+                    neighborPos[axisU]=u;
+
+                    size_t neighborIndex=(neighborPos.z*size.x*size.y)+(neighborPos.y*size.x)+neighborPos.x;
+
+                    if(!empty(neighborCells[neighborIndex]))
+                        continue;
+                }
+
+                addFace<_Chunk, _ChunkMesh>(mesh, face, position, cellType, stride);
+            }
+        }
+    }
+}
+
 template<typename _Chunk, typename _ChunkMesh>
 void buildCubicMesh(_ChunkMesh &mesh, _Chunk *chunk)
 {
     size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
     glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
 
-    const int requiredScratchSize=(size.x+1)*(size.y+1)*(size.z+1);
-    const int requiredIndices=(size.x*size.y*size.z)*6*4;
-    const int requiredVertices=requiredScratchSize;
+    if(chunk->isUniform())
+    {
+        buildUniformMesh(mesh, chunk, stride);
+        return;
+    }
 
-    typename _Chunk::Cells &cells=chunk->getCells();
+    typename _Chunk::CellViewType cells=chunk->getCellView();
     glm::ivec3 position(0, 0, 0);
 
     size_t index=0;
@@ -487,7 +560,7 @@ void buildCubicMesh(_ChunkMesh &mesh, _Chunk *chunk)
 //Neighbor check
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 template<typename _Chunk, typename _ChunkMesh, bool _YNegFace=true, bool _YPosFace=true, bool _ZNegFace=true, bool _ZPosFace=true>
-void checkX_Neighbor(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, glm::ivec3 &position, size_t stride, std::vector<_Chunk *> *neighbors=nullptr)
+void checkX_Neighbor(_ChunkMesh &mesh, const typename _Chunk::CellViewType &cells, size_t &index, glm::ivec3 &position, size_t stride, std::vector<_Chunk *> *neighbors=nullptr)
 {
     position.x=0;
 
@@ -508,7 +581,7 @@ void checkX_Neighbor(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &in
 
 
 template<typename _Chunk, typename _ChunkMesh, bool _ZNegFace=true, bool _ZPosFace=true>
-void checkY_Neighbor(_ChunkMesh &mesh, typename _Chunk::Cells &cells, size_t &index, glm::ivec3 &position, size_t stride, std::vector<_Chunk *> *neighbors=nullptr)
+void checkY_Neighbor(_ChunkMesh &mesh, const typename _Chunk::CellViewType &cells, size_t &index, glm::ivec3 &position, size_t stride, std::vector<_Chunk *> *neighbors=nullptr)
 {
     position.y=0;
 
@@ -534,11 +607,14 @@ void buildCubicMesh_Neighbor(_ChunkMesh &mesh, _Chunk *chunk, std::vector<_Chunk
     size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
     glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
 
-    const int requiredScratchSize=(size.x+1)*(size.y+1)*(size.z+1);
-    const int requiredIndices=(size.x*size.y*size.z)*6*4;
-    const int requiredVertices=requiredScratchSize;
+    //uniform chunks only need work where a neighbor is not solid
+    if(chunk->isUniform())
+    {
+        buildUniformMesh(mesh, chunk, stride, neighbors);
+        return;
+    }
 
-    typename _Chunk::Cells &cells=chunk->getCells();
+    typename _Chunk::CellViewType cells=chunk->getCellView();
     glm::ivec3 position(0, 0, 0);
 
     size_t index=0;
@@ -1,201 +1,191 @@
 #ifndef _voxigen_greedyMeshBuilder_h_
 #define _voxigen_greedyMeshBuilder_h_
 
+#include "voxigen/defines.h"
+#include "voxigen/volume/chunk.h"
+#include "voxigen/meshes/faces.h"
+
+#include <array>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/integer.hpp>
+
+namespace voxigen
+{
+
 namespace greedy
 {
-struct Quad
+//axis the texture x/y runs along for each face, follows the corner order in facesWithNormal
+const std::array<size_t, 6> textureAxisX={1, 1, 0, 0, 0, 0};
+const std::array<size_t, 6> textureAxisY={2, 2, 2, 2, 1, 1};
+
+//adds a face covering extent cells starting at position (in lod cells)
+template<typename _ChunkMesh>
+void addFace(_ChunkMesh &mesh, size_t face, const glm::ivec3 &position, const glm::ivec3 &extent, unsigned int cellType, size_t stride)
 {
-    Quad(const glm::ivec &start, const glm::ivec &delta):start(start), delta(delta) {}
+    auto faceQuad=facesWithNormal[face];
 
-    glm::ivec start;
-    glm::ivec delta;
-};
-}
+    for(size_t i=0; i<4; ++i)
+        faceQuad[i]=(faceQuad[i]*extent+position)*(int)stride;
 
-//template<typename _Chunk, typename _ChunkMesh, bool firstRow=false>
-//void scan(typename _Chunk::Cells *cells, size_t size; size_t pitch, unsigned int *mask)
-//{
-//    size_t index=0;
-//    size_t maskIndex=0;
-//
-//    typename _Chunk::CellType &cell=cells[index];
-//    unsigned int prevCellType=type(cell);
-//    unsigned int cellType;
-//
-//    for(size_t i=1; i<size; ++i)
-//    {
-//        cellType=type(cell);
-//
-//        mask[index]=0;
-//        if(prevCellType!=cellType)
-//            maskIndex=index;
-//        mask[maskIndex]++;
-//
-//        prevCellType=cellType;
-//        index+=pitch;
-//    }
-//}
-//
-//template<typename _Chunk, typename _ChunkMesh>
-//void buildGreedyMesh(_ChunkMesh &mesh, _Chunk *chunk)
-//{
-//    typename _Chunk::Cells &cells=chunk->getCells();
-//
-//    size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
-////    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
-//
-//    size_t maskSize=std::max(size.x*size.y, std::max(size.x*size.z, size.y*size.z));
-//    std::vector<unsigned int> mask(maskSize);
-//    
-//    size_t size[3]={_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride};
-//    size_t pitch[3]={1, size[0], size[0]*size[1]};
-//
-//    size_t quadIndex=0;
-//    std::vector<greedy::Quad> quads(maskSize);
-//    size_t toggle=0;
-//
-//    for(size_t z=0; z<size[2]; ++z)
-//    {
-//        size_t pitch=size[1]*size[0];
-//        size_t prevRowIndex=0;
-//        size_t index=size[0];
-//
-//        for(size_t y=1; y<size[1]; ++y)
-//        {
-//            size_t *prevMask=mask.data()+(size[1]*toggle);
-//            size_t *curMask=mask.data()+(size[1]*(1-toggle));
-//
-//            unsigned int prevCellType=type(cells[index]);
-//            unsigned int cellType;
-//
-//
-////            scan(typename _Chunk::Cells *cells, size_t size; size_t pitch, unsigned int *mask)
-//            scan(&cells[index], size[0], pitch, curMask);
-//
-//            for(size_t x=0; x<size[d0]; ++x)
-//            {
-//                if(curMask[x] > 0)
-//                cells[]
-//            }
-//
-//            toggle=1-toggle;
-//        }
-//    }
-//}
+    glm::ivec2 textureExtent(extent[textureAxisX[face]], extent[textureAxisY[face]]);
 
-template<typename _Chunk, typename _ChunkMesh>
-void scan(_Chunk::CellType *cells, size_t pitch, unsigned int *mask)
+    mesh.addFace(face, cellType, position, faceQuad, textureExtent);
+}
+
+//merges runs of the same value in a slice mask (cell type+1, 0 no face) into rectangles,
+//first along u then along v, position[axis] is the slice. The mask is cleared as it is used
+template<typename _ChunkMesh>
+void mergeMask(_ChunkMesh &mesh, std::vector<unsigned int> &mask, size_t face, glm::ivec3 position, int sizeU, int sizeV, size_t stride)
 {
-    size_t index=0;
-    
-    for(size_t y=0; y<size[1]; ++y)
+    size_t axis=face/2;
+    size_t axisU=(axis+1)%3;
+    size_t axisV=(axis+2)%3;
+    size_t maskIndex=0;
+
+    for(int v=0; v<sizeV; ++v)
     {
-        mask[index]=false;
-        index++;
-        bool prevCellEmpty=empty(cell[cellIndex]);
-        cellIndex+=pitch;
-        for(size_t x=1; x<size[d0]; ++x)
+        for(int u=0; u<sizeU; )
         {
-            bool cellEmpty=empty(cells[cellIndex]);
+            unsigned int value=mask[maskIndex];
+
+            if(value==0)
+            {
+                ++u;
+                ++maskIndex;
+                continue;
+            }
+
+            int width=1;
+
+            while((u+width<sizeU)&&(mask[maskIndex+width]==value))
+                ++width;
+
+            int height=1;
+
+            for(; v+height<sizeV; ++height)
+            {
+                unsigned int *row=&mask[maskIndex+(height*sizeU)];
+                int i=0;
+
+                while((i<width)&&(row[i]==value))
+                    ++i;
+
+                if(i<width)
+                    break;
+            }
+
+            //clear the merged cells so they are not used again
+            for(int j=0; j<height; ++j)
+            {
+                unsigned int *row=&mask[maskIndex+(j*sizeU)];
 
-            mask[index]=(cellEmpty!=prevCellEmpty);
-            
-            index++;
-            cellIndex+=pitch;
-            prevCellEmpty=cellEmpty;
+                for(int i=0; i<width; ++i)
+                    row[i]=0;
+            }
+
+            glm::ivec3 extent(1, 1, 1);
+
+            position[axisU]=u;
+            position[axisV]=v;
+            extent[axisU]=width;
+            extent[axisV]=height;
+
+            addFace(mesh, face, position, extent, value-1, stride);
+
+            u+=width;
+            maskIndex+=width;
         }
     }
 }
 
+}//namespace greedy
+
+//greedy mesher, each slice of the chunk is masked with the visible face types and
+//merged with greedy::mergeMask. Faces on the chunk boundary are always added
+//(same as buildCubicMesh)
 template<typename _Chunk, typename _ChunkMesh>
-void buildGreedyMesh(_ChunkMesh &mesh, _Chunk *chunk, std::vector<greedy::Quad> &quads)
+void buildGreedyMesh(_ChunkMesh &mesh, _Chunk *chunk)
 {
-    typename _Chunk::Cells &cells=chunk->getCells();
-
     size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
-//    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
+    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
+    glm::ivec3 pitch(1, size.x, size.x*size.y);
 
-    size_t maskSize=std::max(size.x*size.y, std::max(size.x*size.z, size.y*size.z));
-    std::vector<unsigned int> mask(maskSize);
-    
-    size_t size[3]={_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride};
-    size_t pitch[3]={1, size[0], size[0]*size[1]};
+    //uniform chunk only has its boundary, one quad per side
+    if(chunk->isUniform())
+    {
+        const typename _Chunk::CellType &cell=chunk->getUniformCell();
 
-    size_t quadIndex=0;
-    std::vector<greedy::Quad> quads(maskSize);
-    size_t toggle=0;
-    glm::ivec point;
+        if(empty(cell))
+            return;
 
-    for(size_t x; x<3; x++)
-    {
-        size_t y=(x+1)%3;
-        size_t z=(x+2)%3;
+        unsigned int cellType=type(cell);
 
-        size_t cellIndexZ;
-        for(pt[z]=0; z<size[z]; ++pt[z])
+        for(size_t face=0; face<6; ++face)
         {
-            cellIndexZ=z*pitch[z];
+            size_t axis=face/2;
+            glm::ivec3 position(0, 0, 0);
+            glm::ivec3 extent=size;
 
-            scan(&cells[cellIndex_z], pitch[x], mask);
+            if((face&1)!=0)
+                position[axis]=size[axis]-1;
+            extent[axis]=1;
 
-            size_t index=0;
-            
-            for(pt[y]=0; y<size[y]; ++pt[y])
-            {
-                cellIndex=y*pitch[y]+cellIndexZ;
+            greedy::addFace(mesh, face, position, extent, cellType, stride);
+        }
+        return;
+    }
 
-                for(pt[x]=0; x<size[x]; )
+    typename _Chunk::CellViewType cells=chunk->getCellView();
+
+    //cell type+1 of the visible face, 0 no face
+    static thread_local std::vector<unsigned int> mask;
+
+    for(size_t face=0; face<6; ++face)
+    {
+        size_t axis=face/2;
+        size_t axisU=(axis+1)%3;
+        size_t axisV=(axis+2)%3;
+        bool positive=(face&1)!=0;
+        int sizeU=size[axisU];
+        int sizeV=size[axisV];
+        int adjOffset=positive?pitch[axis]:-pitch[axis];
+        glm::ivec3 position;
+
+        mask.resize(sizeU*sizeV);
+
+        for(int slice=0; slice<size[axis]; ++slice)
+        {
+            bool boundary=positive?(slice==size[axis]-1):(slice==0);
+            size_t maskIndex=0;
+
+            position[axis]=slice;
+            for(int v=0; v<sizeV; ++v)
+            {
+                position[axisV]=v;
+                for(int u=0; u<sizeU; ++u)
                 {
-                    unsigned int currentType=type(cells[cellIndex]);
+                    position[axisU]=u;
 
-                    if(mask[index])
-                    {
-                        size_t w;
-                        size_t h;
-
-                        mask[index]=false;
-                        unsigned int cellType=type(cells[cellIndex]);
-
-                        for(w=1; mask[index+w]&&(pt[x]+w<size[ix])&&(type(cells[cellIndex])==cellsType); ++w)
-                        {
-                            mask[index+w]=false;
-                            index+=pitch[x];
-                        }
-
-                        size_t localIndex;
-                        for(h+1; h+pt[y]<size[y]; ++h)
-                        {
-                            bool done=false;
-
-                            localIndex=index+pitch[y]*h;
-                            for(size_t i=0; i<w; ++i)
-                            {
-                                if(!mask[localIndex]) || (type(cells[cellIndex])!=cellType))
-                                {
-                                    done=true;
-                                    break;
-                                }
-                                mask[localIndex]=false;
-                                ++localIndex;
-                            }
-                            if(done)
-                                break;
-                        }
-                        quads.emplace_back(point, delta);
-                    }
-                    else
+                    size_t index=(position.z*pitch.z)+(position.y*pitch.y)+position.x;
+                    const typename _Chunk::CellType &cell=cells[index];
+                    unsigned int value=0;
+
+                    if(!empty(cell))
                     {
-                        pt[x]++;
-                        index++;
+                        if(boundary||empty(cells[index+adjOffset]))
+                            value=type(cell)+1;
                     }
-
-                    cellIndex+=pitch[x];
+                    mask[maskIndex++]=value;
                 }
             }
+
+            greedy::mergeMask(mesh, mask, face, position, sizeU, sizeV, stride);
         }
     }
 }
 
-//buildPrudentMesh
+} //namespace voxigen
 
-#endif//_voxigen_greedyMeshBuilder_h_
\ No newline at end of file
+#endif //_voxigen_greedyMeshBuilder_h_
@@ -0,0 +1,109 @@
+#ifndef _voxigen_layeredMeshBuilder_h_
+#define _voxigen_layeredMeshBuilder_h_
+
+#include "voxigen/defines.h"
+#include "voxigen/volume/chunk.h"
+#include "voxigen/meshes/faces.h"
+#include "voxigen/meshbuilders/cubicMeshBuilder.h"
+#include "voxigen/meshbuilders/paddedMeshBuilder.h"
+
+#include <vector>
+
+namespace voxigen
+{
+
+namespace layered
+{
+
+//adds the faces of the cells in layers first to last from the padded cell values (see padded::gather)
+template<typename _Chunk, typename _ChunkMesh>
+void addLayers(_ChunkMesh &mesh, const std::vector<unsigned int> &values, const glm::ivec3 &size, size_t first, size_t last, size_t stride)
+{
+    glm::ivec3 paddedSize=size+2;
+    glm::ivec3 pitch(1, paddedSize.x, paddedSize.x*paddedSize.y);
+    std::array<int, 6> adjOffset={-pitch.x, pitch.x, -pitch.y, pitch.y, -pitch.z, pitch.z};
+    glm::ivec3 position;
+
+    for(size_t layer=first; layer<=last; ++layer)
+    {
+        position.z=(int)layer;
+        for(position.y=0; position.y<size.y; ++position.y)
+        {
+            size_t index=((position.z+1)*pitch.z)+((position.y+1)*pitch.y)+1;
+
+            for(position.x=0; position.x<size.x; ++position.x, ++index)
+            {
+                unsigned int value=values[index];
+
+                if(value==0)
+                    continue;
+
+                for(size_t face=0; face<6; ++face)
+                {
+                    if(values[index+adjOffset[face]]==0)
+                        addFace<_Chunk, _ChunkMesh>(mesh, face, position, value-1, stride);
+                }
+            }
+        }
+        mesh.endLayer(layer);
+    }
+}
+
+}//namespace layered
+
+//one quad per exposed face, quads are ordered by z layer so the mesh can be updated
+//with updateLayeredMesh. Attached neighbors are used as in buildPaddedMesh
+template<typename _Chunk, typename _ChunkMesh>
+void buildLayeredMesh(_ChunkMesh &mesh, _Chunk *chunk)
+{
+    size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
+    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
+
+    static thread_local std::vector<unsigned int> values;
+
+    padded::gather(chunk, size, values);
+
+    mesh.beginLayers(size.z);
+    layered::addLayers<_Chunk, _ChunkMesh>(mesh, values, size, 0, size.z-1, stride);
+}
+
+//remeshes the layers touched by the dirty box (min/max inclusive in lod cells, the chunk's box
+//before clearDirty) plus the layers above/below as their faces against the changed cells may
+//change, and splices them into mesh. Meshes not built with buildLayeredMesh are fully rebuilt.
+//The chunk is only read
+template<typename _Chunk, typename _ChunkMesh>
+void updateLayeredMesh(_ChunkMesh &mesh, _Chunk *chunk, const glm::ivec3 &dirtyMin, const glm::ivec3 &dirtyMax)
+{
+    size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
+    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
+
+    if(!mesh.hasLayers()||(mesh.getLayerCount()!=(size_t)size.z))
+    {
+        mesh.clear();
+        buildLayeredMesh(mesh, chunk);
+        return;
+    }
+
+    if(dirtyMin.z>dirtyMax.z)
+        return;
+
+    size_t first=(size_t)glm::max(dirtyMin.z-1, 0);
+    size_t last=(size_t)glm::min(dirtyMax.z+1, size.z-1);
+
+    static thread_local std::vector<unsigned int> values;
+    static thread_local _ChunkMesh layers;
+
+    padded::gather(chunk, size, values, (int)first, (int)last);
+
+    layers.clear();
+    layers.setFaceTable(mesh.getFaceTable());
+    layers.setIndexMode(_ChunkMesh::IndexMode::Shared);
+    layers.beginLayers(size.z);
+    layered::addLayers<_Chunk, _ChunkMesh>(layers, values, size, first, last, stride);
+
+    mesh.spliceLayers(first, last, layers);
+}
+
+} //namespace voxigen
+
+#endif //_voxigen_layeredMeshBuilder_h_
@@ -0,0 +1,52 @@
+#ifndef _voxigen_meshBuilder_h_
+#define _voxigen_meshBuilder_h_
+
+#include "voxigen/meshbuilders/cubicMeshBuilder.h"
+#include "voxigen/meshbuilders/greedyMeshBuilder.h"
+#include "voxigen/meshbuilders/bitmaskMeshBuilder.h"
+#include "voxigen/meshbuilders/paddedMeshBuilder.h"
+#include "voxigen/meshbuilders/layeredMeshBuilder.h"
+
+namespace voxigen
+{
+
+enum class MeshBuilder
+{
+    Cubic, //one quad per exposed face
+    Greedy, //coplanar faces of the same type merged
+    Bitmask, //one quad per exposed face, culled with occupancy bitmasks
+    Layered //one quad per exposed face, ordered by layer so edits can be remeshed in place
+};
+
+template<typename _Chunk, typename _ChunkMesh>
+void buildMesh(MeshBuilder builder, _ChunkMesh &mesh, _Chunk *chunk)
+{
+    //with neighbors attached (Chunk::setNeighbor) the hidden border faces are dropped, the
+    //bitmask and layered meshers use the neighbors directly, the others mesh a padded copy
+    switch(builder)
+    {
+    case MeshBuilder::Layered:
+        buildLayeredMesh(mesh, chunk);
+        break;
+    case MeshBuilder::Bitmask:
+        buildBitmaskMesh(mesh, chunk);
+        break;
+    case MeshBuilder::Greedy:
+        if(chunk->hasNeighbors())
+            buildPaddedMesh(mesh, chunk, true);
+        else
+            buildGreedyMesh(mesh, chunk);
+        break;
+    case MeshBuilder::Cubic:
+    default:
+        if(chunk->hasNeighbors())
+            buildPaddedMesh(mesh, chunk, false);
+        else
+            buildCubicMesh(mesh, chunk);
+        break;
+    }
+}
+
+} //namespace voxigen
+
+#endif //_voxigen_meshBuilder_h_
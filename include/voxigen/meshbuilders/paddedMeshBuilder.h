@@ -0,0 +1,237 @@
+#ifndef _voxigen_paddedMeshBuilder_h_
+#define _voxigen_paddedMeshBuilder_h_
+
+#include "voxigen/defines.h"
+#include "voxigen/volume/chunk.h"
+#include "voxigen/meshes/faces.h"
+#include "voxigen/meshbuilders/cubicMeshBuilder.h"
+#include "voxigen/meshbuilders/greedyMeshBuilder.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace voxigen
+{
+
+namespace padded
+{
+
+inline unsigned int cellValue(unsigned int cellType, bool isEmpty) { return isEmpty?0:cellType+1; }
+
+//copies the cell types (type+1, 0 empty) of the chunk into a (size+2)^3 volume, the border
+//is filled from the chunk neighbors on the 6 faces. Missing neighbors (or a different lod)
+//are left empty so those faces are added, same as the non padded meshers. Only the layers
+//(z) from firstLayer-1 to lastLayer+1 are filled, the rest of values is left as is
+template<typename _Chunk>
+void gather(_Chunk *chunk, const glm::ivec3 &size, std::vector<unsigned int> &values, int firstLayer, int lastLayer)
+{
+    glm::ivec3 paddedSize=size+2;
+    glm::ivec3 pitch(1, paddedSize.x, paddedSize.x*paddedSize.y);
+
+    //chunk cells copied, z clamped to the chunk
+    glm::ivec3 low(0, 0, std::max(firstLayer-1, 0));
+    glm::ivec3 high(size.x-1, size.y-1, std::min(lastLayer+1, size.z-1));
+
+    values.resize(paddedSize.x*paddedSize.y*paddedSize.z);
+    std::fill(values.begin()+(firstLayer*pitch.z), values.begin()+((lastLayer+3)*pitch.z), 0);
+
+    if(chunk->isUniform())
+    {
+        const typename _Chunk::CellType &cell=chunk->getUniformCell();
+        unsigned int value=cellValue(type(cell), empty(cell));
+
+        if(value!=0)
+        {
+            for(int z=low.z; z<=high.z; ++z)
+            {
+                for(int y=0; y<size.y; ++y)
+                {
+                    unsigned int *row=&values[((z+1)*pitch.z)+((y+1)*pitch.y)+1];
+
+                    std::fill(row, row+size.x, value);
+                }
+            }
+        }
+    }
+    else
+    {
+        typename _Chunk::CellViewType cells=chunk->getCellView();
+        size_t index=low.z*size.x*size.y;
+
+        for(int z=low.z; z<=high.z; ++z)
+        {
+            for(int y=0; y<size.y; ++y)
+            {
+                unsigned int *row=&values[((z+1)*pitch.z)+((y+1)*pitch.y)+1];
+
+                for(int x=0; x<size.x; ++x)
+                {
+                    const typename _Chunk::CellType &cell=cells[index++];
+
+                    row[x]=cellValue(type(cell), empty(cell));
+                }
+            }
+        }
+    }
+
+    if(!chunk->hasNeighbors())
+        return;
+
+    std::vector<_Chunk *> &neighbors=chunk->getNeighbors();
+
+    for(size_t face=0; face<6; ++face)
+    {
+        _Chunk *neighbor=neighbors[face];
+
+        //different lod, cells do not line up
+        if(!neighbor||(neighbor->getLod()!=chunk->getLod()))
+            continue;
+
+        size_t axis=face/2;
+        size_t axisU=(axis+1)%3;
+        size_t axisV=(axis+2)%3;
+        bool positive=(face&1)!=0;
+
+        //z border only needed if the layers reach it
+        if((face==Face::zNeg)&&(firstLayer>0))
+            continue;
+        if((face==Face::zPos)&&(lastLayer<size.z-1))
+            continue;
+
+        glm::ivec3 paddedPos;
+        glm::ivec3 neighborPos;
+
+        paddedPos[axis]=positive?size[axis]+1:0;
+        neighborPos[axis]=positive?0:size[axis]-1;
+
+        if(neighbor->isUniform())
+        {
+            const typename _Chunk::CellType &cell=neighbor->getUniformCell();
+            unsigned int value=cellValue(type(cell), empty(cell));
+
+            if(value==0)
+                continue;
+
+            for(int v=low[axisV]; v<=high[axisV]; ++v)
+            {
+                paddedPos[axisV]=v+1;
+                for(int u=low[axisU]; u<=high[axisU]; ++u)
+                {
+                    paddedPos[axisU]=u+1;
+                    values[(paddedPos.z*pitch.z)+(paddedPos.y*pitch.y)+paddedPos.x]=value;
+                }
+            }
+            continue;
+        }
+
+        typename _Chunk::CellViewType neighborCells=neighbor->getCellView();
+
+        for(int v=low[axisV]; v<=high[axisV]; ++v)
+        {
+            paddedPos[axisV]=v+1;
+            neighborPos[axisV]=v;
+            for(int u=low[axisU]; u<=high[axisU]; ++u)
+            {
+                paddedPos[axisU]=u+1;
+                neighborPos[axisU]=u;
+
+                size_t neighborIndex=(neighborPos.z*size.x*size.y)+(neighborPos.y*size.x)+neighborPos.x;
+                const typename _Chunk::CellType &cell=neighborCells[neighborIndex];
+
+                values[(paddedPos.z*pitch.z)+(paddedPos.y*pitch.y)+paddedPos.x]=cellValue(type(cell), empty(cell));
+            }
+        }
+    }
+}
+
+template<typename _Chunk>
+void gather(_Chunk *chunk, const glm::ivec3 &size, std::vector<unsigned int> &values)
+{
+    gather(chunk, size, values, 0, size.z-1);
+}
+
+}//namespace padded
+
+//meshes against a padded copy of the chunk so faces against solid neighbor cells are culled,
+//the neighbors are attached to the chunk (Chunk::setNeighbor) before meshing. With merge
+//the visible faces are merged as in buildGreedyMesh otherwise one quad per face is added
+template<typename _Chunk, typename _ChunkMesh>
+void buildPaddedMesh(_ChunkMesh &mesh, _Chunk *chunk, bool merge)
+{
+    size_t stride=glm::pow(2u, (unsigned int)chunk->getLod());
+    glm::ivec3 size(_Chunk::sizeX::value/stride, _Chunk::sizeY::value/stride, _Chunk::sizeZ::value/stride);
+    glm::ivec3 paddedSize=size+2;
+    glm::ivec3 pitch(1, paddedSize.x, paddedSize.x*paddedSize.y);
+
+    static thread_local std::vector<unsigned int> values;
+    static thread_local std::vector<unsigned int> mask;
+
+    padded::gather(chunk, size, values);
+
+    for(size_t face=0; face<6; ++face)
+    {
+        size_t axis=face/2;
+        size_t axisU=(axis+1)%3;
+        size_t axisV=(axis+2)%3;
+        int sizeU=size[axisU];
+        int sizeV=size[axisV];
+        int adjOffset=((face&1)!=0)?pitch[axis]:-pitch[axis];
+        glm::ivec3 position;
+
+        mask.resize(sizeU*sizeV);
+
+        for(int slice=0; slice<size[axis]; ++slice)
+        {
+            size_t maskIndex=0;
+            bool hasFaces=false;
+
+            position[axis]=slice;
+            for(int v=0; v<sizeV; ++v)
+            {
+                position[axisV]=v;
+                for(int u=0; u<sizeU; ++u)
+                {
+                    position[axisU]=u;
+
+                    size_t index=((position.z+1)*pitch.z)+((position.y+1)*pitch.y)+(position.x+1);
+                    unsigned int value=values[index];
+
+                    if((value!=0)&&(values[index+adjOffset]!=0))
+                        value=0;
+
+                    hasFaces|=(value!=0);
+                    mask[maskIndex++]=value;
+                }
+            }
+
+            if(!hasFaces)
+                continue;
+
+            if(merge)
+            {
+                greedy::mergeMask(mesh, mask, face, position, sizeU, sizeV, stride);
+                continue;
+            }
+
+            maskIndex=0;
+            for(int v=0; v<sizeV; ++v)
+            {
+                position[axisV]=v;
+                for(int u=0; u<sizeU; ++u)
+                {
+                    unsigned int value=mask[maskIndex++];
+
+                    if(value==0)
+                        continue;
+
+                    position[axisU]=u;
+                    addFace<_Chunk, _ChunkMesh>(mesh, face, position, value-1, stride);
+                }
+            }
+        }
+    }
+}
+
+} //namespace voxigen
+
+#endif //_voxigen_paddedMeshBuilder_h_
@@ -5,16 +5,53 @@
 #include "voxigen/volume/chunk.h"
 #include "voxigen/texturing/textureAtlas.h"
 #include "voxigen/meshes/meshBuffer.h"
+#include "voxigen/meshes/faces.h"
 
 #include <array>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <cassert>
 
 namespace voxigen
 {
 
 
+//quad indices 0, 1, 2, 0, 2, 3 offset by the quads first vertex
+template<typename _Index>
+void writeQuadIndices(_Index *indices, _Index vertIndex)
+{
+    indices[0]=vertIndex;
+    indices[1]=vertIndex+1;
+    indices[2]=vertIndex+2;
+    indices[3]=vertIndex;
+    indices[4]=vertIndex+2;
+    indices[5]=vertIndex+3;
+}
+
+//fills indices for quads, used to build a quad index buffer shared by meshes without indices
+inline void generateQuadIndices(std::vector<uint32_t> &indices, size_t quads)
+{
+    indices.resize(quads*6);
+
+    for(size_t i=0; i<quads; ++i)
+        writeQuadIndices(&indices[i*6], (uint32_t)(i*4));
+}
+
+//vertex/index storage is only grown, clear() resets the write position so a mesh that is
+//reused (per thread scratch or pooled) does not allocate once it has reached its working size.
+//A mesh can also share the buffers of a built mesh that is never modified (see share)
 class ChunkTextureMesh
 {
 public:
+    enum class IndexMode
+    {
+        Mesh, //mesh stores its indices, 16 bit while the vertices fit
+        Shared //no indices, drawn with a shared quad index buffer (see generateQuadIndices)
+    };
+
     struct Vertex
     {
         uint8_t x, y, z, w; //w used for barycentric position
@@ -23,154 +60,518 @@ public:
         uint32_t data;
     };
 
-    ChunkTextureMesh(){};
-    ChunkTextureMesh(TextureAtlas const *textureAtlas):m_textureAtlas(textureAtlas) {};
-
-    void setTextureAtlas(TextureAtlas const *textureAtlas)
+    //vertex attributes of every (cell type, face) built from the texture atlas, faces are
+    //emitted by copying the template and setting the position. Types outside the atlas
+    //use the last entry
+    class FaceTable
     {
-        m_textureAtlas=textureAtlas; 
+    public:
+        struct Entry
+        {
+            std::array<Vertex, 4> vertexes;
+            uint16_t tileX, tileY; //repeat tile counts, 0 if the texture does not repeat
+            std::array<uint16_t, 4> tile; //texture tile origin and size, texture coords wrap inside it
+        };
 
-        short resolution=(short)m_textureAtlas->resolution();
+        FaceTable():m_textureAtlas(nullptr), m_types(0), m_resolution(0) {}
 
-        textOffsetX[0]=0;
-        textOffsetX[1]=resolution;
-        textOffsetX[2]=resolution;
-        textOffsetX[3]=0;
+        void build(TextureAtlas const *textureAtlas);
 
-        textOffsetY[0]=0;
-        textOffsetY[1]=0;
-        textOffsetY[2]=resolution;
-        textOffsetY[3]=resolution;
-    }
-    void addFace(size_t face, unsigned int cellType, const glm::ivec3 &position, const std::array<glm::ivec3, 5> &quad);
+        TextureAtlas const *getTextureAtlas() const { return m_textureAtlas; }
+        uint16_t resolution() const { return m_resolution; }
 
-    std::vector<Vertex> &getVertexes() { return m_verticies; }
-    std::vector<int> &getIndexes() { return m_indices; }
+        const Entry &get(unsigned int cellType, size_t face) const { return m_entries[(std::min<size_t>(cellType, m_types)*6)+face]; }
+        //tile of every entry for the shader (looked up by vertex data and normal), a row
+        //of 6 faces per cell type
+        void getTiles(std::vector<uint16_t> &tiles) const;
 
-    size_t memoryUsed();
+    private:
+        TextureAtlas const *m_textureAtlas;
+        size_t m_types;
+        uint16_t m_resolution;
+
+        std::vector<Entry> m_entries;
+    };
+
+    ChunkTextureMesh():m_textureAtlas(nullptr), m_faceTable(nullptr), m_indexMode(IndexMode::Mesh), m_wideIndices(false), m_faceGroups(false), m_layered(false), m_vertexCount(0) {};
+    ChunkTextureMesh(TextureAtlas const *textureAtlas):m_textureAtlas(textureAtlas), m_faceTable(nullptr), m_indexMode(IndexMode::Mesh), m_wideIndices(false), m_faceGroups(false), m_layered(false), m_vertexCount(0) {};
+
+    void setTextureAtlas(TextureAtlas const *textureAtlas) { m_textureAtlas=textureAtlas; }
+    //table has to be built from the same texture atlas, required for addFace
+    void setFaceTable(FaceTable const *faceTable) { m_faceTable=faceTable; }
+    FaceTable const *getFaceTable() const { return m_faceTable; }
+
+    //extent is the size of the face in cells along the texture x/y axis, greater than 1 for merged faces
+    void addFace(size_t face, unsigned int cellType, const glm::ivec3 &position, const std::array<glm::ivec3, 5> &quad, const glm::ivec2 &extent=glm::ivec2(1, 1));
+
+    //returns write pointer for the 4 vertices of a quad, the quads indices are added
+    Vertex *emitQuad();
+
+    const Vertex *getVertexData() const { return vertices().data(); }
+    size_t getVertexCount() const { return m_vertexCount; }
+    //set before building, existing indices are not converted
+    void setIndexMode(IndexMode mode) { m_indexMode=mode; }
+    IndexMode getIndexMode() const { return m_indexMode; }
+
+    //indices needed to draw the mesh, Shared meshes have no index data
+    size_t getIndexCount() const { return (m_vertexCount/4)*6; }
+    //32 bit indices once the vertices no longer fit 16 bit
+    bool wideIndices() const { return m_wideIndices; }
+    size_t getIndexSize() const { return m_wideIndices?sizeof(uint32_t):sizeof(uint16_t); }
+    const void *getIndexData() const;
+
+    //reorders the quads so each face direction is one contiguous range, indices only
+    //depend on the quad position so they stay valid. Call after building
+    void groupFaces();
+    bool hasFaceGroups() const { return m_faceGroups; }
+    //first quad of each face direction, [6] is the quad count
+    const std::array<unsigned int, 7> &getFaceGroups() const { return m_faceGroupStart; }
+
+    //quads ordered by layer (chunk z slice), layer ranges allow part of the mesh to be
+    //replaced with spliceLayers. beginLayers before adding faces, endLayer after each layer
+    void beginLayers(size_t layers);
+    void endLayer(size_t layer) { m_layerStart[layer+1]=(unsigned int)(m_vertexCount/4); }
+    bool hasLayers() const { return m_layered; }
+    size_t getLayerCount() const { return m_layerStart.empty()?0:m_layerStart.size()-1; }
+    //replaces the quads of layers first to last (inclusive) with the quads of layers, which
+    //only has those layers built
+    void spliceLayers(size_t first, size_t last, const ChunkTextureMesh &layers);
+
+    size_t memoryUsed() const;
 
     void reserve(size_t vertexCount, size_t indexCount);
     void clear();
+    //hands the buffers to another mesh without copying (texture atlas stays)
+    void swap(ChunkTextureMesh &mesh);
+    //copies the built mesh (used part of the buffers only), texture atlas and face table stay
+    void copy(const ChunkTextureMesh &mesh);
+    //uses the buffers of mesh without copying, they are copied out if this mesh is modified
+    //(groupFaces, spliceLayers). Texture atlas and face table stay
+    void share(const std::shared_ptr<const ChunkTextureMesh> &mesh);
+    bool isShared() const { return (bool)m_shared; }
 
 private:
+    //buffers holding the built mesh, the shared mesh's if there is one
+    const std::vector<Vertex> &vertices() const { return m_shared?m_shared->m_verticies:m_verticies; }
+    const std::vector<uint16_t> &indices16() const { return m_shared?m_shared->m_indices16:m_indices16; }
+    const std::vector<uint32_t> &indices32() const { return m_shared?m_shared->m_indices32:m_indices32; }
+    void unshare();
+
     TextureAtlas const *m_textureAtlas;
-    std::array<short, 4> textOffsetX;
-    std::array<short, 4> textOffsetY;
+    FaceTable const *m_faceTable;
 
     std::vector<Vertex> m_verticies;
-    std::vector<int> m_indices;
+    void addQuadIndices(size_t vertIndex);
+    static size_t vertexFace(const Vertex &vertex);
+
+    IndexMode m_indexMode;
+    bool m_wideIndices;
+    bool m_faceGroups;
+    bool m_layered;
+    std::vector<unsigned int> m_layerStart; //first quad of each layer, back is the quad count
+    std::array<unsigned int, 7> m_faceGroupStart;
+
+    std::vector<uint16_t> m_indices16;
+    std::vector<uint32_t> m_indices32;
+    std::vector<Vertex> m_groupVertices; //staging for groupFaces, stays with this mesh on swap
+    size_t m_vertexCount;
+
+    std::shared_ptr<const ChunkTextureMesh> m_shared;
 };
 
-inline void ChunkTextureMesh::addFace(size_t face, unsigned int cellType, const glm::ivec3 &position, const std::array<glm::ivec3, 5> &quad)
+typedef std::shared_ptr<const ChunkTextureMesh> SharedChunkTextureMesh;
+
+inline ChunkTextureMesh::Vertex *ChunkTextureMesh::emitQuad()
 {
-    size_t index=m_verticies.size();
-    size_t vertIndex=index;
-    m_verticies.resize(index+4);
+    assert(!m_shared);
+
+    //grow geometrically, only until the mesh reaches its working size
+    if(m_vertexCount+4>m_verticies.size())
+        m_verticies.resize(std::max<size_t>(m_verticies.size()*2, 4096));
+
+    if(m_indexMode==IndexMode::Mesh)
+        addQuadIndices(m_vertexCount);
 
-    TextureAtlas::TextureEntry entry;
+    Vertex *vertex=&m_verticies[m_vertexCount];
+
+    m_vertexCount+=4;
+    return vertex;
+}
 
-    if(cellType<m_textureAtlas->size())
+inline void ChunkTextureMesh::addQuadIndices(size_t vertIndex)
+{
+    size_t index=(vertIndex/4)*6;
+
+    //switch to 32 bit once the quad does not fit, copying what was already added
+    if(!m_wideIndices && (vertIndex+3>std::numeric_limits<uint16_t>::max()))
     {
-        const TextureAtlas::BlockEntry &block=m_textureAtlas->getBlockEntry(cellType);
-        entry=block.faces[face];
+        m_indices32.resize(std::max<size_t>(m_indices32.size(), index*2));
+        std::copy(m_indices16.begin(), m_indices16.begin()+index, m_indices32.begin());
+        m_wideIndices=true;
+    }
+
+    if(m_wideIndices)
+    {
+        if(index+6>m_indices32.size())
+            m_indices32.resize(m_indices32.size()*2);
+        writeQuadIndices(&m_indices32[index], (uint32_t)vertIndex);
     }
     else
     {
-        entry.method=LayerMethod::unknown;
-        entry.x=0;
-        entry.y=0;
+        if(index+6>m_indices16.size())
+            m_indices16.resize(std::max<size_t>(m_indices16.size()*2, 6144));
+        writeQuadIndices(&m_indices16[index], (uint16_t)vertIndex);
     }
+}
+
+inline size_t ChunkTextureMesh::vertexFace(const Vertex &vertex)
+{
+    if(vertex.nx!=0)
+        return (vertex.nx>0)?Face::xPos:Face::xNeg;
+    if(vertex.ny!=0)
+        return (vertex.ny>0)?Face::yPos:Face::yNeg;
+    return (vertex.nz>0)?Face::zPos:Face::zNeg;
+}
+
+inline void ChunkTextureMesh::groupFaces()
+{
+    unshare();
+
+    size_t quads=m_vertexCount/4;
+    std::array<unsigned int, 6> next={0, 0, 0, 0, 0, 0};
 
-    short texX=(short)entry.x;
-    short texY=(short)entry.y;
-    short resolution=(short)m_textureAtlas->resolution();
+    for(size_t i=0; i<quads; ++i)
+        next[vertexFace(m_verticies[i*4])]++;
 
-    if(entry.method==LayerMethod::repeat)
+    m_faceGroupStart[0]=0;
+    for(size_t face=0; face<6; ++face)
     {
-        glm::ivec2 texPos;
+        m_faceGroupStart[face+1]=m_faceGroupStart[face]+next[face];
+        next[face]=m_faceGroupStart[face];
+    }
+
+    if(m_groupVertices.size()<m_vertexCount)
+        m_groupVertices.resize(m_vertexCount);
+
+    for(size_t i=0; i<quads; ++i)
+    {
+        const Vertex *quad=&m_verticies[i*4];
+        unsigned int &quadIndex=next[vertexFace(*quad)];
+
+        memcpy(&m_groupVertices[quadIndex*4], quad, sizeof(Vertex)*4);
+        quadIndex++;
+    }
+
+    m_verticies.swap(m_groupVertices);
+    m_faceGroups=true;
+    //quads no longer in layer order
+    m_layered=false;
+}
+
+inline void ChunkTextureMesh::beginLayers(size_t layers)
+{
+    m_layerStart.assign(layers+1, (unsigned int)(m_vertexCount/4));
+    m_layered=true;
+}
+
+inline void ChunkTextureMesh::spliceLayers(size_t first, size_t last, const ChunkTextureMesh &layers)
+{
+    assert(m_layered&&(last<getLayerCount()));
+
+    unshare();
+
+    size_t quads=m_vertexCount/4;
+    size_t begin=m_layerStart[first];
+    size_t end=m_layerStart[last+1];
+    size_t newBegin=layers.m_layerStart[first];
+    size_t newQuads=layers.m_layerStart[last+1]-newBegin;
+    size_t spliceQuads=quads-(end-begin)+newQuads;
+
+    if(spliceQuads*4>m_verticies.size())
+        m_verticies.resize(std::max(spliceQuads*4, m_verticies.size()*2));
+
+    //move the following layers into place then copy in the rebuilt ones
+    if(end<quads)
+        memmove(&m_verticies[(begin+newQuads)*4], &m_verticies[end*4], (quads-end)*4*sizeof(Vertex));
+    if(newQuads>0)
+        memcpy(&m_verticies[begin*4], &layers.vertices()[newBegin*4], newQuads*4*sizeof(Vertex));
 
-        if(face<=Face::back)
+    for(size_t layer=first; layer<=last; ++layer)
+        m_layerStart[layer+1]=(unsigned int)(begin+(layers.m_layerStart[layer+1]-newBegin));
+    for(size_t layer=last+1; layer<getLayerCount(); ++layer)
+        m_layerStart[layer+1]=(unsigned int)(m_layerStart[layer+1]-end+begin+newQuads);
+
+    //indices are positional, only quads past the old count need them
+    if(m_indexMode==IndexMode::Mesh)
+    {
+        for(size_t quad=quads; quad<spliceQuads; ++quad)
+            addQuadIndices(quad*4);
+    }
+
+    m_vertexCount=spliceQuads*4;
+    m_faceGroups=false;
+}
+
+inline const void *ChunkTextureMesh::getIndexData() const
+{
+    if(m_indexMode==IndexMode::Shared)
+        return nullptr;
+    return m_wideIndices?(const void *)indices32().data():(const void *)indices16().data();
+}
+
+namespace textureCorner
+{
+//texture offset (in tiles) of the face corners
+const std::array<uint16_t, 4> x={0, 1, 1, 0};
+const std::array<uint16_t, 4> y={0, 0, 1, 1};
+}
+
+inline void ChunkTextureMesh::FaceTable::build(TextureAtlas const *textureAtlas)
+{
+    m_textureAtlas=textureAtlas;
+    m_types=textureAtlas->size();
+    m_resolution=(uint16_t)textureAtlas->resolution();
+
+    //extra type at the end for cell types missing from the atlas
+    m_entries.resize((m_types+1)*6);
+
+    for(size_t cellType=0; cellType<=m_types; ++cellType)
+    {
+        for(size_t face=0; face<6; ++face)
         {
-            if(face<=Face::right)
+            TextureAtlas::TextureEntry textureEntry;
+
+            if(cellType<m_types)
+                textureEntry=textureAtlas->getBlockEntry(cellType).faces[face];
+            else
             {
-                texPos.x=position.y%entry.tileX;
-                if(face==Face::right)
-                    texPos.x=entry.tileX-texPos.x;
+                textureEntry.method=LayerMethod::unknown;
+                textureEntry.x=0;
+                textureEntry.y=0;
+            }
+
+            Entry &entry=m_entries[(cellType*6)+face];
+            const glm::ivec3 &normal=facesWithNormal[face][4];
+            uint16_t tileWidth=m_resolution;
+            uint16_t tileHeight=m_resolution;
+
+            if(textureEntry.method==LayerMethod::repeat)
+            {
+                entry.tileX=(uint16_t)textureEntry.tileX;
+                entry.tileY=(uint16_t)textureEntry.tileY;
+                tileWidth=entry.tileX*m_resolution;
+                tileHeight=entry.tileY*m_resolution;
             }
             else
             {
-                texPos.x=position.x%entry.tileX;
-                if(face==Face::back)
-                    texPos.x=entry.tileX-texPos.x;
+                entry.tileX=0;
+                entry.tileY=0;
             }
-            texPos.y=position.z%entry.tileY;
-        }
-        else
-        {
-            texPos.x=position.x%entry.tileX;
-            texPos.y=position.y%entry.tileY;
-            if(face==Face::top)
+
+            for(size_t i=0; i<4; ++i)
             {
-                texPos.x=entry.tileX-texPos.x;
-                texPos.y=entry.tileY-texPos.y;
+                Vertex &vertex=entry.vertexes[i];
+
+                vertex.x=0;
+                vertex.y=0;
+                vertex.z=0;
+                vertex.w=(uint8_t)i;
+                vertex.nx=normal.x;
+                vertex.ny=normal.y;
+                vertex.nz=normal.z;
+                vertex.tx=(uint16_t)textureEntry.x+textureCorner::x[i]*m_resolution;
+                vertex.ty=(uint16_t)textureEntry.y+textureCorner::y[i]*m_resolution;
+                vertex.data=(uint32_t)cellType;
             }
+
+            entry.tile={(uint16_t)textureEntry.x, (uint16_t)textureEntry.y, tileWidth, tileHeight};
         }
+    }
+}
+
+inline void ChunkTextureMesh::FaceTable::getTiles(std::vector<uint16_t> &tiles) const
+{
+    tiles.resize(m_entries.size()*4);
+
+    for(size_t i=0; i<m_entries.size(); ++i)
+        std::copy(m_entries[i].tile.begin(), m_entries[i].tile.end(), &tiles[i*4]);
+}
 
-        texX=texX+(texPos.x%entry.tileX)*resolution;
-        texY=texY+(texPos.y%entry.tileY)*resolution;
+//tile of a repeating texture used at position
+inline glm::ivec2 repeatTile(size_t face, const glm::ivec3 &position, int tileX, int tileY)
+{
+    glm::ivec2 texPos;
+
+    if(face<=Face::back)
+    {
+        if(face<=Face::right)
+        {
+            texPos.x=position.y%tileX;
+            if(face==Face::right)
+                texPos.x=tileX-texPos.x;
+        }
+        else
+        {
+            texPos.x=position.x%tileX;
+            if(face==Face::back)
+                texPos.x=tileX-texPos.x;
+        }
+        texPos.y=position.z%tileY;
     }
+    else
+    {
+        texPos.x=position.x%tileX;
+        texPos.y=position.y%tileY;
+        if(face==Face::top)
+        {
+            texPos.x=tileX-texPos.x;
+            texPos.y=tileY-texPos.y;
+        }
+    }
+
+    return glm::ivec2(texPos.x%tileX, texPos.y%tileY);
+}
+
+inline void ChunkTextureMesh::addFace(size_t face, unsigned int cellType, const glm::ivec3 &position, const std::array<glm::ivec3, 5> &quad, const glm::ivec2 &extent)
+{
+    const FaceTable::Entry &entry=m_faceTable->get(cellType, face);
+    Vertex *vertexes=emitQuad();
 
-//    std::vector<short> textOffsetX={0, resolution, resolution, 0};
-//    std::vector<short> textOffsetY={0, 0, resolution, resolution};
+    memcpy(vertexes, entry.vertexes.data(), sizeof(Vertex)*4);
 
     for(size_t i=0; i<4; ++i)
     {
-        Vertex &vertex=m_verticies[index];
+        Vertex &vertex=vertexes[i];
 
         vertex.x=quad[i].x;
         vertex.y=quad[i].y;
         vertex.z=quad[i].z;
-        vertex.w=(uint8_t)i;
-        vertex.nx=quad[4].x;
-        vertex.ny=quad[4].y;
-        vertex.nz=quad[4].z;
-        vertex.tx=texX+textOffsetX[i];
-        vertex.ty=texY+textOffsetY[i];
         vertex.data=cellType;
-        index++;
     }
 
-    size_t indicesIndex=m_indices.size();
-    m_indices.resize(indicesIndex+6);
+    if((entry.tileX==0)&&(extent.x==1)&&(extent.y==1))
+        return;
+
+    uint16_t resolution=m_faceTable->resolution();
+    glm::ivec2 offset(0, 0);
+
+    if(entry.tileX!=0)
+        offset=repeatTile(face, position, entry.tileX, entry.tileY)*(int)resolution;
 
-    m_indices[indicesIndex++]=vertIndex;
-    m_indices[indicesIndex++]=vertIndex+1;
-    m_indices[indicesIndex++]=vertIndex+2;
-    m_indices[indicesIndex++]=vertIndex;
-    m_indices[indicesIndex++]=vertIndex+2;
-    m_indices[indicesIndex]=vertIndex+3;
+    //merged faces cover extent tiles, the shader wraps inside the tile
+    glm::ivec2 extentOffset=(extent-1)*(int)resolution;
+
+    for(size_t i=0; i<4; ++i)
+    {
+        Vertex &vertex=vertexes[i];
+
+        vertex.tx+=offset.x+textureCorner::x[i]*extentOffset.x;
+        vertex.ty+=offset.y+textureCorner::y[i]*extentOffset.y;
+    }
 }
 
-inline size_t ChunkTextureMesh::memoryUsed()
+inline size_t ChunkTextureMesh::memoryUsed() const
 {
     size_t memoryUsed=0;
 
-    memoryUsed+=m_verticies.size()*sizeof(Vertex);
-    memoryUsed+=m_indices.size()*sizeof(int);
+    memoryUsed+=m_vertexCount*sizeof(Vertex);
+    if(m_indexMode==IndexMode::Mesh)
+        memoryUsed+=getIndexCount()*getIndexSize();
 
     return memoryUsed;
 }
 
 inline void ChunkTextureMesh::reserve(size_t vertexCount, size_t indexCount)
 {
-    m_verticies.reserve(vertexCount);
-    m_indices.reserve(indexCount);
+    if(m_verticies.size()<vertexCount)
+        m_verticies.resize(vertexCount);
+    if(m_indices16.size()<indexCount)
+        m_indices16.resize(indexCount);
 }
 
 inline void ChunkTextureMesh::clear()
 {
-    m_verticies.clear();
-    m_indices.clear();
+    m_vertexCount=0;
+    m_wideIndices=false;
+    m_faceGroups=false;
+    m_layered=false;
+    m_shared.reset();
+}
+
+inline void ChunkTextureMesh::swap(ChunkTextureMesh &mesh)
+{
+    m_verticies.swap(mesh.m_verticies);
+    m_indices16.swap(mesh.m_indices16);
+    m_indices32.swap(mesh.m_indices32);
+    std::swap(m_indexMode, mesh.m_indexMode);
+    std::swap(m_wideIndices, mesh.m_wideIndices);
+    std::swap(m_faceGroups, mesh.m_faceGroups);
+    std::swap(m_faceGroupStart, mesh.m_faceGroupStart);
+    std::swap(m_layered, mesh.m_layered);
+    m_layerStart.swap(mesh.m_layerStart);
+    std::swap(m_vertexCount, mesh.m_vertexCount);
+    m_shared.swap(mesh.m_shared);
+}
+
+inline void ChunkTextureMesh::copy(const ChunkTextureMesh &mesh)
+{
+    //keep the source alive if it is the mesh this one shares
+    SharedChunkTextureMesh shared;
+
+    shared.swap(m_shared);
+
+    m_indexMode=mesh.m_indexMode;
+    m_wideIndices=mesh.m_wideIndices;
+    m_faceGroups=mesh.m_faceGroups;
+    m_faceGroupStart=mesh.m_faceGroupStart;
+    m_layered=mesh.m_layered;
+    m_layerStart=mesh.m_layerStart;
+    m_vertexCount=mesh.m_vertexCount;
+
+    if(m_verticies.size()<m_vertexCount)
+        m_verticies.resize(m_vertexCount);
+    std::copy(mesh.vertices().begin(), mesh.vertices().begin()+m_vertexCount, m_verticies.begin());
+
+    if(m_indexMode==IndexMode::Shared)
+        return;
+
+    size_t indexCount=getIndexCount();
+
+    if(m_wideIndices)
+    {
+        if(m_indices32.size()<indexCount)
+            m_indices32.resize(indexCount);
+        std::copy(mesh.indices32().begin(), mesh.indices32().begin()+indexCount, m_indices32.begin());
+    }
+    else
+    {
+        if(m_indices16.size()<indexCount)
+            m_indices16.resize(indexCount);
+        std::copy(mesh.indices16().begin(), mesh.indices16().begin()+indexCount, m_indices16.begin());
+    }
+}
+
+inline void ChunkTextureMesh::share(const std::shared_ptr<const ChunkTextureMesh> &mesh)
+{
+    m_indexMode=mesh->m_indexMode;
+    m_wideIndices=mesh->m_wideIndices;
+    m_faceGroups=mesh->m_faceGroups;
+    m_faceGroupStart=mesh->m_faceGroupStart;
+    m_layered=mesh->m_layered;
+    m_layerStart=mesh->m_layerStart;
+    m_vertexCount=mesh->m_vertexCount;
+    //always the mesh holding the buffers
+    m_shared=mesh->m_shared?mesh->m_shared:mesh;
+}
+
+inline void ChunkTextureMesh::unshare()
+{
+    if(!m_shared)
+        return;
+
+    SharedChunkTextureMesh shared=m_shared;
+
+    copy(*shared);
 }
 
 } //namespace voxigen
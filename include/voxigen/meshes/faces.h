@@ -22,6 +22,30 @@ const size_t front=2;
 const size_t back=3;
 const size_t bottom=4;
 const size_t top=5;
+
+const unsigned int all=0x3f;
+}
+
+//bit per face direction that can be seen from position for faces inside the box min/max,
+//a face is only visible from the side its normal points to
+inline unsigned int visibleFaces(const glm::vec3 &position, const glm::vec3 &min, const glm::vec3 &max)
+{
+    unsigned int mask=0;
+
+    if(position.x<max.x)
+        mask|=1<<Face::xNeg;
+    if(position.x>min.x)
+        mask|=1<<Face::xPos;
+    if(position.y<max.y)
+        mask|=1<<Face::yNeg;
+    if(position.y>min.y)
+        mask|=1<<Face::yPos;
+    if(position.z<max.z)
+        mask|=1<<Face::zNeg;
+    if(position.z>min.z)
+        mask|=1<<Face::zPos;
+
+    return mask;
 }
 
 const std::array<std::array<glm::ivec3, 4>, 6> faces=
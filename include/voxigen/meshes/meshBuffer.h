@@ -3,6 +3,7 @@
 
 //#include "voxigen/defines.h"
 #include <glbinding/gl/gl.h>
+#include <array>
 //typedef struct __GLsync *GLsync;
 
 namespace voxigen
@@ -10,7 +11,7 @@ namespace voxigen
 
 struct MeshBuffer
 {
-    MeshBuffer():valid(false), ready(false) {}
+    MeshBuffer():valid(false), ready(false), sharedIndexBuffer(false), faceGroups(false) {}
 
     bool valid;
     bool ready;
@@ -21,6 +22,10 @@ struct MeshBuffer
     unsigned int indices;
 
     unsigned int indexType;
+    bool sharedIndexBuffer; //indexBuffer is not owned by the mesh
+
+    bool faceGroups; //quads are grouped by face direction, see ChunkTextureMesh::groupFaces
+    std::array<unsigned int, 7> faceGroupStart;
 
     gl::GLsync sync;
     unsigned int frame;
@@ -0,0 +1,68 @@
+#ifndef _voxigen_meshCache_h_
+#define _voxigen_meshCache_h_
+
+#include "voxigen/defines.h"
+#include "voxigen/lruCache.h"
+#include "voxigen/meshes/chunkTextureMesh.h"
+
+#include <array>
+#include <cstdint>
+
+namespace voxigen
+{
+
+//identifies a built mesh, settings holds anything else the mesh depends on (mesher,
+//attached neighbors, index mode, ...) packed by the renderer. Neighbor revisions follow
+//the chunk faces indexing, 0 for faces without a neighbor
+struct MeshCacheKey
+{
+    MeshCacheKey():region(0), chunk(0), lod(0), revision(0), atlasVersion(0), settings(0) { neighborRevisions.fill(0); }
+    MeshCacheKey(RegionHash region, ChunkHash chunk, size_t lod, unsigned int revision, unsigned int atlasVersion, uint32_t settings):
+        region(region), chunk(chunk), lod((uint32_t)lod), revision(revision), atlasVersion(atlasVersion), settings(settings) { neighborRevisions.fill(0); }
+
+    bool operator==(const MeshCacheKey &key) const
+    {
+        return (region==key.region)&&(chunk==key.chunk)&&(lod==key.lod)&&(revision==key.revision)&&
+            (atlasVersion==key.atlasVersion)&&(settings==key.settings)&&(neighborRevisions==key.neighborRevisions);
+    }
+
+    RegionHash region;
+    ChunkHash chunk;
+    uint32_t lod;
+    uint32_t revision;
+    uint32_t atlasVersion;
+    uint32_t settings;
+    std::array<uint32_t, 6> neighborRevisions;
+};
+
+struct MeshCacheKeyHash
+{
+    size_t operator()(const MeshCacheKey &key) const
+    {
+        uint64_t value=((uint64_t)key.region<<32)|key.chunk;
+
+        value^=((uint64_t)key.lod<<32|key.revision)*0x9e3779b97f4a7c15ull;
+        value^=((uint64_t)key.atlasVersion<<32|key.settings)*0xc2b2ae3d27d4eb4full;
+        for(size_t i=0; i<key.neighborRevisions.size(); i+=2)
+            value^=((uint64_t)key.neighborRevisions[i]<<32|key.neighborRevisions[i+1])*(0x165667b19e3779f9ull+i);
+        return std::hash<uint64_t>()(value);
+    }
+};
+
+//entries count their built size against the capacity
+struct MeshCacheCost
+{
+    size_t operator()(const ChunkTextureMesh &mesh) const { return mesh.memoryUsed(); }
+};
+
+//built chunk meshes shared by the mesh threads, bounded by memory. Entries are compact
+//meshes that are never modified, meshes share them (see ChunkTextureMesh::share)
+class MeshCache:public LruCache<MeshCacheKey, ChunkTextureMesh, MeshCacheKeyHash, MeshCacheCost>
+{
+public:
+    MeshCache(size_t maxMemory=64*1024*1024):LruCache(maxMemory) {}
+};
+
+}//namespace voxigen
+
+#endif //_voxigen_meshCache_h_
@@ -0,0 +1,55 @@
+#ifndef _voxigen_parallelFor_h_
+#define _voxigen_parallelFor_h_
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+namespace voxigen
+{
+
+inline size_t parallelBlockCount(size_t count, size_t blockSize) { return (count+blockSize-1)/blockSize; }
+
+//runs function(block, begin, end) over [0, count) split into blockSize blocks, on up to
+//threadCount threads (0 uses the hardware thread count) including the calling thread.
+//Returns once every block is done. Blocks only depend on count and blockSize, results
+//kept per block and merged in block order are the same for any thread count
+template<typename _Function>
+void parallelFor(size_t count, size_t blockSize, _Function function, size_t threadCount=0)
+{
+    size_t blocks=parallelBlockCount(count, blockSize);
+
+    if(blocks==0)
+        return;
+
+    if(threadCount==0)
+        threadCount=std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    threadCount=std::min(threadCount, blocks);
+
+    std::atomic<size_t> nextBlock(0);
+
+    auto run=[&]()
+    {
+        for(size_t block=nextBlock++; block<blocks; block=nextBlock++)
+        {
+            size_t begin=block*blockSize;
+
+            function(block, begin, std::min(begin+blockSize, count));
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for(size_t i=1; i<threadCount; ++i)
+        threads.emplace_back(run);
+
+    run();
+
+    for(std::thread &thread:threads)
+        thread.join();
+}
+
+}//namespace voxigen
+
+#endif //_voxigen_parallelFor_h_
@@ -9,6 +9,8 @@
 #include <glm/glm.hpp>
 
 #include <functional>
+#include <algorithm>
+#include <cstdlib>
 
 namespace voxigen
 {
@@ -97,6 +99,8 @@ struct Request
     size_t priority;
     Position position;
     size_t result;
+    //next request of a generate batch, the worker generates the whole batch (see ProcessThread)
+    Request *batch;
 
     union Data
     {
@@ -113,6 +117,14 @@ struct Request
         return details::distance(regionIndex, chunkIndex, position.region, position.chunk, regionSize, chunkSize);
     }
 
+    //chebyshev distance in chunks, the ring around the position the request is on
+    int ringDistance(const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex) const
+    {
+        glm::ivec3 offset=details::difference(regionIndex, chunkIndex, position.region, position.chunk, regionSize);
+
+        return std::max(std::abs(offset.x), std::max(std::abs(offset.y), std::abs(offset.z)));
+    }
+
     //TODO: currently a hack to make it work
     static glm::ivec3 regionSize;
     static glm::ivec3 chunkSize;
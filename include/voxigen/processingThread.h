@@ -7,6 +7,8 @@
 #include "voxigen/volume/chunkHandle.h"
 #include "voxigen/processRequests.h"
 #include "voxigen/queueThread.h"
+#include "voxigen/workStealingExecutor.h"
+#include "voxigen/asyncIo.h"
 #include "voxigen/fileio/log.h"
 
 #include <generic/objectHeap.h>
@@ -16,6 +18,7 @@
 #include <queue>
 #include <mutex>
 #include <atomic>
+#include <unordered_map>
 
 namespace voxigen
 {
@@ -33,6 +36,8 @@ public:
     void setSizes(glm::ivec3 &regionSize, glm::ivec3 &chunkSize);
 
     void setIoRequestCallback(process::Callback callback);
+    //reads the io thread can do asynchronously, see AsyncIo
+    void setIoAsyncCallbacks(AsyncIo::PrepareCallback prepare, AsyncIo::CompleteCallback complete);
     void setChunkRequestCallback(process::Callback callback);
     void setMeshRequestCallback(process::Callback callback);
 
@@ -84,6 +89,61 @@ public:
     bool defaultCallback(process::Request *request) { return true; }
 
 private:
+    //requests are coalesced by the object they act on (chunk handle, renderer) and type
+    struct RequestKey
+    {
+        RequestKey(void *object, process::Type type):object(object), type(type) {}
+
+        bool operator==(const RequestKey &key) const { return (object==key.object)&&(type==key.type); }
+
+        void *object;
+        process::Type type;
+    };
+
+    struct RequestKeyHash
+    {
+        size_t operator()(const RequestKey &key) const { return std::hash<void *>()(key.object)^((size_t)key.type<<1); }
+    };
+    typedef std::unordered_map<RequestKey, process::Request *, RequestKeyHash> RequestMap;
+
+    //generate requests are batched by column (region, chunk x/y and lod)
+    struct ColumnKey
+    {
+        ColumnKey(process::Request *request):region(request->position.region), chunk(request->position.chunk.x, request->position.chunk.y), lod(request->data.chunk.lod) {}
+
+        bool operator==(const ColumnKey &key) const { return (region==key.region)&&(chunk==key.chunk)&&(lod==key.lod); }
+
+        glm::ivec3 region;
+        glm::ivec2 chunk;
+        size_t lod;
+    };
+
+    struct ColumnKeyHash
+    {
+        size_t operator()(const ColumnKey &key) const
+        {
+            size_t hash=std::hash<int>()(key.region.x);
+
+            hash=(hash*31)^std::hash<int>()(key.region.y);
+            hash=(hash*31)^std::hash<int>()(key.region.z);
+            hash=(hash*31)^std::hash<int>()(key.chunk.x);
+            hash=(hash*31)^std::hash<int>()(key.chunk.y);
+            return (hash*31)^key.lod;
+        }
+    };
+    typedef std::unordered_map<ColumnKey, process::Request *, ColumnKeyHash> ColumnMap;
+
+    static RequestKey getRequestKey(process::Request *request);
+    //request type and its cancel map to each other
+    static process::Type oppositeType(process::Type type);
+    static bool isCancel(process::Type type);
+    //removes a request that has not been sent to the coordination thread yet, cancels
+    //are released and anything else is completed as canceled
+    bool dropPendingRequest(const RequestKey &key);
+    //hands back the rest of each completed generate batch, batches whose first request was
+    //canceled are queued again
+    static void completeBatches(RequestQueue &completedQueue, RequestQueue &requestQueue);
+
     bool requestMeshAction(process::Type type, size_t priority, void *renderer, void *mesh, const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex);
     bool requestChunkAction(process::Type type, size_t priority, void *chunkHandle, size_t lod, const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex);
 
@@ -103,6 +163,8 @@ private:
     generic::ObjectHeap<process::Request> m_requests;
     RequestQueue m_requestQueue;
     RequestQueue m_requestsComplete;
+    RequestMap m_pendingRequests; //in m_requestQueue, not sent yet
+    RequestMap m_inFlightRequests; //sent, not completed
 #ifndef NDEBUG
     //used to verify single thread access
     std::thread::id m_requestThreadId;
@@ -121,8 +183,8 @@ private:
     
 //    generic::ObjectHeap<ChunkTextureMesh> m_meshHeap;
 
-    QueueThread m_ioThread;
-    QueueThread m_workerThread;
+    AsyncIo m_ioThread;
+    WorkStealingExecutor m_workerThread;
 };
 
 VOXIGEN_EXPORT ProcessThread &getProcessThread();
@@ -8,6 +8,7 @@
 #include <thread>
 #include <queue>
 #include <mutex>
+#include <condition_variable>
 
 namespace voxigen
 {
@@ -20,6 +21,13 @@ public:
     QueueThread(std::condition_variable *completeEvent);
 
     void setCallback(process::Callback callback);
+    //when set a callback returning false leaves the request in flight, it is 
+    //only completed when completeRequest is called
+    void setDeferCompletion(bool defer) { m_deferCompletion=defer; }
+    void completeRequest(process::Request *request);
+    //hands an in flight request back to the threads, it is processed again ahead of the queue
+    //and is not affected by cancels
+    void requeueRequest(process::Request *request);
 
     void start(size_t threadCount=1);
     void stop();
@@ -44,7 +52,9 @@ private:
     std::condition_variable *m_completeEvent;
 
     bool m_run;
+    bool m_deferCompletion;
     RequestQueue m_queue;
+    RequestQueue m_requeued;
     RequestQueue m_completedQueue;
 };
 
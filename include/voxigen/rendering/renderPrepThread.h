@@ -7,6 +7,7 @@
 #include "voxigen/texturing/textureAtlas.h"
 //#include "voxigen/nativeGL.h"
 #include "voxigen/meshes/chunkTextureMesh.h"
+#include "voxigen/meshbuilders/meshBuilder.h"
 //#include "voxigen/meshBuffer.h"
 
 #include <generic/objectHeap.h>
@@ -110,6 +111,9 @@ public:
 
     void updateQueues(Requests &completedQueue);// ChunkRenderers &added, ChunkRenderers &updated, ChunkRenderers &removed);
 
+    //only change while the thread is stopped
+    void setMeshBuilder(MeshBuilder builder) { m_meshBuilder=builder; }
+
 //    void start(NativeGL *nativeGL);
 //    void start(DataType *dataType, Initialize init, Terminate term);
     void start();
@@ -154,6 +158,10 @@ private:
     Requests m_completedQueue;
     generic::ObjectHeap<Request> m_requests;
     generic::ObjectHeap<voxigen::ChunkTextureMesh> m_meshes;
+
+    MeshBuilder m_meshBuilder;
+    //only used on the process thread, rebuilt when the requests texture atlas changes
+    ChunkTextureMesh::FaceTable m_faceTable;
 ///////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////
@@ -8,7 +8,8 @@ namespace voxigen
 template<typename _DataType, typename _Object>
 RenderPrepThread<_DataType, _Object>::RenderPrepThread(size_t requestSize):
     m_requests(requestSize),
-    m_meshes(50)
+    m_meshes(50),
+    m_meshBuilder(MeshBuilder::Cubic)
 {
 }
 
@@ -381,31 +382,27 @@ bool RenderPrepThread<_DataType, _Object>::buildMesh(Request *request, voxigen::
         request);
 #endif//DEBUG_MESH
 
+    //face table only changes with the atlas
+    if(m_faceTable.getTextureAtlas()!=objectMesh.textureAtlas)
+        m_faceTable.build(objectMesh.textureAtlas);
+
     mesh->clear();
     mesh->setTextureAtlas(objectMesh.textureAtlas);
 
     scratchMesh->clear();
     scratchMesh->setTextureAtlas(objectMesh.textureAtlas);
+    scratchMesh->setFaceTable(&m_faceTable);
 
     auto chunk=object->getHandle()->chunk();
 
 //    if(chunk->hasNeighbors())
 //        voxigen::buildCubicMesh_Neighbor(*scratchMesh, chunk, chunk->getNeighbors());
 //    else
-        voxigen::buildCubicMesh(*scratchMesh, chunk);
+        voxigen::buildMesh(m_meshBuilder, *scratchMesh, chunk);
+
+    //hand the built buffers to the mesh, scratch takes the mesh's old buffers
+    mesh->swap(*scratchMesh);
 
-    std::vector<Mesh::Vertex> &vertexes=scratchMesh->getVertexes();
-    std::vector<int> &indexes=scratchMesh->getIndexes();
-    
-    //copy from scratch to allocated mesh
-    std::vector<Mesh::Vertex> &meshVertexes=mesh->getVertexes();
-    std::vector<int> &meshIndexes=mesh->getIndexes();
-
-    meshVertexes.resize(vertexes.size());
-    memcpy(meshVertexes.data(), vertexes.data(), vertexes.size()*sizeof(Mesh::Vertex));
-    meshIndexes.resize(indexes.size());
-    memcpy(meshIndexes.data(), indexes.data(), indexes.size()*sizeof(int));
-    
     request->data.objectMesh.mesh=mesh;
     return true;
 }
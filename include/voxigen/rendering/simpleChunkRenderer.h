@@ -7,7 +7,7 @@
 #include "voxigen/volume/chunk.h"
 #include "voxigen/volume/chunkHandle.h"
 #include "voxigen/volume/chunkInfo.h"
-#include "voxigen/meshbuilders/cubicMeshBuilder.h"
+#include "voxigen/meshbuilders/meshBuilder.h"
 #include "voxigen/texturing/textureAtlas.h"
 #include "voxigen/meshes/chunkTextureMesh.h"
 #include "voxigen/rendering/renderAction.h"
@@ -16,6 +16,7 @@
 
 #include <string>
 #include <vector>
+#include <array>
 #include <glm/glm.hpp>
 #include <glm/ext.hpp>
 
@@ -99,6 +100,8 @@ public:
 
     static void useProgram();
     static void updateProgramProjection(const glm::mat4 &projection);
+    //camera position in the same space as the draw offset, used to skip face groups facing away
+    static void updateCameraPosition(const glm::vec3 &position) { m_cameraPosition=position; }
     static void useOutlineProgram();
     static void updateOutlineProgramProjection(const glm::mat4 &projection);
 
@@ -120,6 +123,19 @@ public:
 
     MeshState getMeshState() { return m_meshState; }
     void setMeshState(MeshState state) { m_meshState=state; }
+
+    //neighbor chunks held in use while meshing, follows the faces indexing
+    std::array<SharedChunkHandle, 6> &getMeshNeighbors() { return m_meshNeighbors; }
+    //faces that had a neighbor attached when last meshed
+    unsigned int getMeshNeighborMask() { return m_meshNeighborMask; }
+    void setMeshNeighborMask(unsigned int mask) { m_meshNeighborMask=mask; }
+    //set with a mesh request for the kept layered mesh, only the layers in the dirty box
+    //(lod cells, inclusive) are rebuilt instead of the whole mesh
+    bool isMeshUpdate() { return m_meshUpdate; }
+    const glm::ivec3 &getMeshDirtyMin() { return m_meshDirtyMin; }
+    const glm::ivec3 &getMeshDirtyMax() { return m_meshDirtyMax; }
+    void setMeshUpdate(const glm::ivec3 &dirtyMin, const glm::ivec3 &dirtyMax) { m_meshUpdate=true; m_meshDirtyMin=dirtyMin; m_meshDirtyMax=dirtyMax; }
+    void clearMeshUpdate() { m_meshUpdate=false; }
     
 
     Key getKey(){return Key(m_chunkHandle->regionHash(), m_chunkHandle->hash());}
@@ -216,6 +232,7 @@ private:
     static opengl_util::Program m_program;
     static size_t m_projectionViewId;
     static size_t m_offsetId;
+    static glm::vec3 m_cameraPosition;
 
     static bool m_outlineShaderLoaded;
 //    static std::string vertOutlineShader;
@@ -235,6 +252,11 @@ private:
     unsigned int m_queryId;
 
     MeshState m_meshState;
+    std::array<SharedChunkHandle, 6> m_meshNeighbors;
+    unsigned int m_meshNeighborMask;
+    bool m_meshUpdate;
+    glm::ivec3 m_meshDirtyMin;
+    glm::ivec3 m_meshDirtyMax;
     MeshBuffer m_meshBuffer;
     glm::vec3 m_chunkOffset;
 
@@ -25,6 +25,9 @@ size_t SimpleChunkRenderer<_Region, _Chunk>::m_projectionViewId;
 template<typename _Region, typename _Chunk>
 size_t SimpleChunkRenderer<_Region, _Chunk>::m_offsetId;
 
+template<typename _Region, typename _Chunk>
+glm::vec3 SimpleChunkRenderer<_Region, _Chunk>::m_cameraPosition(0.0f, 0.0f, 0.0f);
+
 template<typename _Region, typename _Chunk>
 opengl_util::Program SimpleChunkRenderer<_Region, _Chunk>::m_outlineProgram;
 
@@ -51,6 +54,8 @@ SimpleChunkRenderer<_Region, _Chunk>::SimpleChunkRenderer():
 m_state(ChunkState::Init),
 m_action(RenderAction::Idle),
 m_meshState(MeshState::Invalid),
+m_meshNeighborMask(0),
+m_meshUpdate(false),
 m_chunkOffset(0.0f, 0.0f, 0.0f), 
 refCount(0),
 m_lodUpdated(false),
@@ -129,6 +134,10 @@ void SimpleChunkRenderer<_Region, _Chunk>::buildPrograms()
         m_renderShaderLoaded=true;
         m_projectionViewId=m_program.getUniformId("projectionView");
         m_offsetId=m_program.getUniformId("regionOffset");
+
+        //tile table on texture unit 1, the atlas is on 0
+        m_program.use();
+        gl::glUniform1i(gl::glGetUniformLocation(m_program.id(), "tileTable"), 1);
     }
 
     insertFrag<<"vec3 dim=vec3("<<(float)ChunkType::sizeX::value<<", "<<(float)ChunkType::sizeY::value<<", "<<(float)ChunkType::sizeZ::value<<");\n";
@@ -202,6 +211,8 @@ template<typename _Region, typename _Chunk>
 void SimpleChunkRenderer<_Region, _Chunk>::setChunk(SharedChunkHandle chunk)
 {
     m_chunkHandle=chunk;
+    m_meshNeighborMask=0;
+    m_meshUpdate=false;
 
     updateInfoText();
 
@@ -386,6 +397,8 @@ void SimpleChunkRenderer<_Region, _Chunk>::release()
 
 //    m_action=RenderAction::Idle;
     m_chunkHandle.reset();
+    m_meshNeighborMask=0;
+    m_meshUpdate=false;
     m_memoryUsed=0;
 
     m_meshBuffer.valid=false;
@@ -462,7 +475,36 @@ void SimpleChunkRenderer<_Region, _Chunk>::draw(const glm::ivec3 &offset)
         gl::glBindVertexArray(m_vertexArray);
 
         // Draw the mesh
-        gl::glDrawElements(gl::GL_TRIANGLES, m_meshBuffer.indices, (gl::GLenum)m_meshBuffer.indexType, 0);
+        if(m_meshBuffer.faceGroups)
+        {
+            unsigned int faces=visibleFaces(m_cameraPosition, renderOffset, renderOffset+glm::vec3(getSize()));
+            size_t indexSize=((gl::GLenum)m_meshBuffer.indexType==gl::GL_UNSIGNED_SHORT)?sizeof(uint16_t):sizeof(uint32_t);
+            size_t face=0;
+
+            //one draw per run of visible face groups
+            while(face<6)
+            {
+                if((faces&(1<<face))==0)
+                {
+                    ++face;
+                    continue;
+                }
+
+                size_t end=face+1;
+
+                while((end<6)&&((faces&(1<<end))!=0))
+                    ++end;
+
+                unsigned int firstQuad=m_meshBuffer.faceGroupStart[face];
+                unsigned int quads=m_meshBuffer.faceGroupStart[end]-firstQuad;
+
+                if(quads>0)
+                    gl::glDrawElements(gl::GL_TRIANGLES, quads*6, (gl::GLenum)m_meshBuffer.indexType, (gl::GLvoid *)(firstQuad*6*indexSize));
+                face=end;
+            }
+        }
+        else
+            gl::glDrawElements(gl::GL_TRIANGLES, m_meshBuffer.indices, (gl::GLenum)m_meshBuffer.indexType, 0);
 //        assert(gl::glGetError()==gl::GL_NO_ERROR);
         checkGLError();
     }
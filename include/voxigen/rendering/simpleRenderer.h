@@ -10,6 +10,7 @@
 #include "voxigen/rendering/simpleChunkRenderer.h"
 #include "voxigen/rendering/simpleRegionRenderer.h"
 #include "voxigen/rendering/simpleShapes.h"
+#include "voxigen/meshes/meshCache.h"
 #include "voxigen/object.h"
 //#include "voxigen/rendering/renderPrepThread.h"
 #include "voxigen/volume/activeVolume.h"
@@ -24,6 +25,7 @@
 #include <glm/ext.hpp>
 #include <opengl_util/program.h>
 #include <deque>
+#include <memory>
 
 namespace voxigen
 {
@@ -142,7 +144,23 @@ public:
     size_t getRendererCount();
 //    void updateChunks();
 
-    void setTextureAtlas(SharedTextureAtlas textureAtlas) { m_textureAtlas=textureAtlas; m_textureAtlasDirty=true; }
+    void setTextureAtlas(SharedTextureAtlas textureAtlas);
+    void setMeshBuilder(MeshBuilder builder) { m_meshBuilder=builder; }
+    MeshBuilder getMeshBuilder() const { return m_meshBuilder; }
+    //chunk meshes are built without indices and drawn with a shared quad index buffer, off by default
+    void setSharedQuadIndices(bool shared) { m_sharedQuadIndices=shared; }
+    bool getSharedQuadIndices() const { return m_sharedQuadIndices; }
+    //chunk meshes are grouped by face direction, groups facing away from the camera are not
+    //drawn. Off by default
+    void setFaceGroups(bool faceGroups) { m_faceGroups=faceGroups; }
+    bool getFaceGroups() const { return m_faceGroups; }
+    //built meshes are kept by chunk revision so chunks coming back into view skip meshing
+    MeshCache &getMeshCache() { return m_meshCache; }
+
+    //edits a cell of a loaded chunk, see ActiveVolume::setCell. With MeshBuilder::Layered
+    //later edits of the chunk only remesh the changed layers
+    bool setCell(const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex, const glm::ivec3 &cellIndex, const typename _Grid::CellType &cell)
+    { return m_activeVolume.setCell(regionIndex, chunkIndex, cellIndex, cell); }
 
 //    typename ActiveVolumeType::VolumeInfo &getVolumeInfo();
 
@@ -202,6 +220,7 @@ private:
 
     void uploadMeshes();
     void uploadMesh(MeshUpdate &update);
+    void reserveQuadIndices(size_t quads);
 //    void uploadMesh(process::Request *request);
     void completeMeshUploads();
 
@@ -254,8 +273,24 @@ private:
     std::vector<RegionRendererType *> m_releaseRegion;
 
     gl::GLuint m_textureAtlasId;
+    gl::GLuint m_tileTableId; //texture tile per cell type/face, see FaceTable::getTiles
     SharedTextureAtlas m_textureAtlas;
     bool m_textureAtlasDirty;
+    //face table and the atlas version it was built for, published together with
+    //std::atomic_store, meshes in flight keep the previous table alive
+    struct AtlasFaceTable
+    {
+        ChunkTextureMesh::FaceTable faceTable;
+        unsigned int version;
+    };
+    std::shared_ptr<AtlasFaceTable> m_faceTable;
+    unsigned int m_textureAtlasVersion; //incremented with each atlas, main thread only
+    MeshBuilder m_meshBuilder;
+    bool m_sharedQuadIndices;
+    bool m_faceGroups;
+    MeshCache m_meshCache;
+    gl::GLuint m_quadIndexBuffer;
+    size_t m_quadIndexCapacity; //in quads
 
 
 //    typedef std::vector<ChunkRenderType *> SearchRing;
@@ -342,6 +377,9 @@ private:
 //    size_t m_chunksMeshing;
     size_t m_meshUploading;
 
+    //initial scratch size, a single full layer of faces
+    static const size_t ScratchMeshVertices=ChunkType::sizeX::value*ChunkType::sizeY::value*4;
+    static const size_t ScratchMeshIndices=ChunkType::sizeX::value*ChunkType::sizeY::value*6; //only used without shared indices
     static thread_local ChunkTextureMesh m_threadScratchMesh;
 };
 
@@ -27,6 +27,12 @@ m_queryComplete(true),
 //    std::bind(&SimpleRenderer<_Grid>::getFreeRegionRenderer, this),
 //    std::bind(&SimpleRenderer<_Grid>::releaseRegionRenderer, this, std::placeholders::_1)),
 m_activeVolume(grid, &grid->getDescriptors()),
+m_textureAtlasVersion(0),
+m_meshBuilder(MeshBuilder::Cubic),
+m_sharedQuadIndices(false),
+m_faceGroups(false),
+m_quadIndexBuffer(0),
+m_quadIndexCapacity(0),
 m_showRegions(true),
 m_showChunks(true),
 //m_chunksLoaded(0),
@@ -94,8 +100,13 @@ void SimpleRenderer<_Grid>::build()
     glBufferData(GL_ARRAY_BUFFER, sizeof(float)*outlineVertices.size(), outlineVertices.data(), GL_STATIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+    //shared indices for chunk meshes, sized as meshes are uploaded
+    glGenBuffers(1, &m_quadIndexBuffer);
+    m_quadIndexCapacity=0;
+
     //build texture for textureAtlas
     glGenTextures(1, &m_textureAtlasId);
+    glGenTextures(1, &m_tileTableId);
 
     loadShaders();
 
@@ -158,6 +169,10 @@ void SimpleRenderer<_Grid>::destroy()
 //    m_regionRenderers.clear();
     m_chunkRenderers.clear();
 
+    glDeleteBuffers(1, &m_quadIndexBuffer);
+    m_quadIndexBuffer=0;
+    m_quadIndexCapacity=0;
+
     gltTerminate();
 }
 
@@ -193,6 +208,17 @@ void SimpleRenderer<_Grid>::draw()
 
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+            //tiles the chunk shader wraps merged faces in, published with the atlas
+            std::shared_ptr<AtlasFaceTable> faceTable=std::atomic_load(&m_faceTable);
+            std::vector<uint16_t> tiles;
+
+            faceTable->faceTable.getTiles(tiles);
+            glBindTexture(GL_TEXTURE_2D, m_tileTableId);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16UI, 6, (GLsizei)(tiles.size()/(6*4)), 0, GL_RGBA_INTEGER, GL_UNSIGNED_SHORT, tiles.data());
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         }
         m_textureAtlasDirty=false;
     }
@@ -224,6 +250,8 @@ void SimpleRenderer<_Grid>::draw()
     updateOcclusionQueries();
 #endif //OCCLUSSION_QUERY
 
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_tileTableId);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, m_textureAtlasId);
 
@@ -241,6 +269,7 @@ void SimpleRenderer<_Grid>::draw()
         ChunkRendererType::useProgram();
         if(cameraDirty)
             ChunkRendererType::updateProgramProjection(m_camera->getProjectionViewMat());
+        ChunkRendererType::updateCameraPosition(m_camera->getPosition());
 //        m_activeChunkVolume.draw();
 //        drawActiveVolume<0>(m_activeChunkVolume);
         drawActiveVolume<Draw::ChunkVolume, Draw::Normal>();
@@ -612,15 +641,11 @@ void SimpleRenderer<_Grid>::uploadMesh(MeshUpdate &update)
     MeshUpload &meshUpload=m_meshUploads.back();
     MeshBuffer &meshBuffer=meshUpload.meshBuffer;
 
-    gl::glGenBuffers(1, &meshBuffer.vertexBuffer);
-    gl::glGenBuffers(1, &meshBuffer.indexBuffer);
-
-    auto &verticies=mesh->getVertexes();
-    std::vector<int> &indices=mesh->getIndexes();
+    size_t vertexCount=mesh->getVertexCount();
+    size_t indexCount=mesh->getIndexCount();
 
     meshBuffer.frame=0;
     meshBuffer.ready=false;
-    meshBuffer.indexType=(unsigned int)gl::GL_UNSIGNED_INT;
 
 #ifdef DEBUG_MESH
     glm::ivec3 regionIndex=renderer->getRegionIndex();
@@ -632,18 +657,38 @@ void SimpleRenderer<_Grid>::uploadMesh(MeshUpdate &update)
         chunkIndex.x, chunkIndex.y, chunkIndex.z);
 #endif//DEBUG_MESH
 
-    if(!indices.empty())
+    if(indexCount>0)
     {
+        gl::glGenBuffers(1, &meshBuffer.vertexBuffer);
         gl::glBindBuffer(gl::GL_ARRAY_BUFFER, meshBuffer.vertexBuffer);
-        gl::glBufferData(gl::GL_ARRAY_BUFFER, verticies.size()*sizeof(ChunkTextureMesh::Vertex), verticies.data(), gl::GL_STATIC_DRAW);
+        gl::glBufferData(gl::GL_ARRAY_BUFFER, vertexCount*sizeof(ChunkTextureMesh::Vertex), mesh->getVertexData(), gl::GL_STATIC_DRAW);
+
+        if(mesh->getIndexMode()==ChunkTextureMesh::IndexMode::Shared)
+        {
+            reserveQuadIndices(vertexCount/4);
+
+            meshBuffer.indexBuffer=m_quadIndexBuffer;
+            meshBuffer.indexType=(unsigned int)gl::GL_UNSIGNED_INT;
+            meshBuffer.sharedIndexBuffer=true;
+        }
+        else
+        {
+            gl::glGenBuffers(1, &meshBuffer.indexBuffer);
+            gl::glBindBuffer(gl::GL_ELEMENT_ARRAY_BUFFER, meshBuffer.indexBuffer);
+            gl::glBufferData(gl::GL_ELEMENT_ARRAY_BUFFER, indexCount*mesh->getIndexSize(), mesh->getIndexData(), gl::GL_STATIC_DRAW);
+
+            meshBuffer.indexType=(unsigned int)(mesh->wideIndices()?gl::GL_UNSIGNED_INT:gl::GL_UNSIGNED_SHORT);
+            meshBuffer.sharedIndexBuffer=false;
+        }
 
-        gl::glBindBuffer(gl::GL_ELEMENT_ARRAY_BUFFER, meshBuffer.indexBuffer);
-        gl::glBufferData(gl::GL_ELEMENT_ARRAY_BUFFER, indices.size()*sizeof(uint32_t), indices.data(), gl::GL_STATIC_DRAW);
+        meshBuffer.faceGroups=mesh->hasFaceGroups();
+        if(meshBuffer.faceGroups)
+            meshBuffer.faceGroupStart=mesh->getFaceGroups();
 
         meshBuffer.sync=gl::glFenceSync(gl::GL_SYNC_GPU_COMMANDS_COMPLETE, gl::UnusedMask::GL_NONE_BIT);
 
         meshBuffer.valid=true;
-        meshBuffer.indices=indices.size();
+        meshBuffer.indices=indexCount;
 
 //        info.request=request;
 //        m_meshUpdate.push_back(info);
@@ -656,12 +701,41 @@ void SimpleRenderer<_Grid>::uploadMesh(MeshUpdate &update)
 #ifdef DEBUG_MESH
         Log::debug("MainThread - Mesh upload %llx - indices empty ", update.mesh);
 #endif//DEBUG_MESH
-        //nothing to upload likely canceled, dump it
-//        m_releaseMeshes.emplace_back(update.container, update.mesh);
+        //nothing to draw (canceled or edited away), drop the previous mesh and return this one
+        MeshBuffer emptyMesh;
+        MeshBuffer prevMesh=renderer->setMesh(emptyMesh);
+
+        if(prevMesh.valid)
+        {
+            gl::glDeleteBuffers(1, &prevMesh.vertexBuffer);
+            if(!prevMesh.sharedIndexBuffer)
+                gl::glDeleteBuffers(1, &prevMesh.indexBuffer);
+        }
+
+        renderer->setAction(RenderAction::Idle);
+        renderer->setMeshState(MeshState::Ready);
+        m_releaseMeshes.emplace_back(update.container, update.mesh);
         m_meshUploads.pop_back();
     }
 }
 
+template<typename _Grid>
+void SimpleRenderer<_Grid>::reserveQuadIndices(size_t quads)
+{
+    if(quads<=m_quadIndexCapacity)
+        return;
+
+    //grow to the largest mesh, buffer name stays the same so meshes already bound keep working
+    m_quadIndexCapacity=std::max(quads, m_quadIndexCapacity*2);
+
+    std::vector<uint32_t> indices;
+
+    generateQuadIndices(indices, m_quadIndexCapacity);
+
+    gl::glBindBuffer(gl::GL_ELEMENT_ARRAY_BUFFER, m_quadIndexBuffer);
+    gl::glBufferData(gl::GL_ELEMENT_ARRAY_BUFFER, indices.size()*sizeof(uint32_t), indices.data(), gl::GL_STATIC_DRAW);
+}
+
 //template<typename _Grid>
 //void SimpleRenderer<_Grid>::updateChunkHandles(bool &regionsUpdated, bool &chunksUpdated)
 //{
@@ -992,7 +1066,8 @@ void SimpleRenderer<_Grid>::completeMeshUploads()
                 if(prevMesh.valid)
                 {
                     gl::glDeleteBuffers(1, &prevMesh.vertexBuffer);
-                    gl::glDeleteBuffers(1, &prevMesh.indexBuffer); 
+                    if(!prevMesh.sharedIndexBuffer)
+                        gl::glDeleteBuffers(1, &prevMesh.indexBuffer);
                 }
 
 //                m_mesherThread.returnMesh(request->getMesh());
@@ -1111,6 +1186,26 @@ size_t SimpleRenderer<_Grid>::getRendererCount()
     return m_activeVolume.getChunkContainerCount();
 }
 
+template<typename _Grid>
+void SimpleRenderer<_Grid>::setTextureAtlas(SharedTextureAtlas textureAtlas)
+{
+    std::shared_ptr<AtlasFaceTable> faceTable;
+
+    m_textureAtlasVersion++;
+    if(textureAtlas)
+    {
+        faceTable=std::make_shared<AtlasFaceTable>();
+        faceTable->faceTable.build(textureAtlas.get());
+        faceTable->version=m_textureAtlasVersion;
+    }
+
+    m_textureAtlas=textureAtlas;
+    //read by the mesh workers
+    std::atomic_store(&m_faceTable, faceTable);
+    m_activeVolume.setFaceTable(faceTable?&faceTable->faceTable:nullptr);
+    m_textureAtlasDirty=true;
+}
+
 template<typename _Grid>
 void SimpleRenderer<_Grid>::setPlayerChunk(const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex)
 {
@@ -1205,13 +1300,55 @@ bool SimpleRenderer<_Grid>::buildMesh(process::Request *request)
         request);
 #endif//DEBUG_MESH
 
+    std::shared_ptr<AtlasFaceTable> atlasFaceTable=std::atomic_load(&m_faceTable);
+    auto chunk=renderer->getHandle()->chunk();
+
+    //kept layered mesh of an edited chunk, only the edited layers are rebuilt
+    if(renderer->isMeshUpdate()&&chunk&&atlasFaceTable)
+    {
+        mesh->setFaceTable(&atlasFaceTable->faceTable);
+        updateLayeredMesh(*mesh, chunk, renderer->getMeshDirtyMin(), renderer->getMeshDirtyMax());
+        return true;
+    }
+
     mesh->clear();
-    mesh->setTextureAtlas(m_textureAtlas.get());
 
-    m_threadScratchMesh.clear();
-    m_threadScratchMesh.setTextureAtlas(m_textureAtlas.get());
+    //data released before the mesh was built, nothing to mesh
+    if(!chunk)
+        return false;
 
-    auto chunk=renderer->getHandle()->chunk();
+    //texture atlas not set yet, no faces to build from
+    if(!atlasFaceTable)
+        return false;
+
+    ChunkTextureMesh::FaceTable *faceTable=&atlasFaceTable->faceTable;
+
+    //everything besides the chunk the mesh depends on
+    uint32_t meshSettings=(uint32_t)m_meshBuilder|(renderer->getMeshNeighborMask()<<8)|
+        (m_sharedQuadIndices?(1<<14):0)|(m_faceGroups?(1<<15):0);
+    MeshCacheKey cacheKey(renderer->getRegionHash(), renderer->getChunkHash(), chunk->getLod(), chunk->getRevision(), atlasFaceTable->version, meshSettings);
+    auto &neighbors=chunk->getNeighbors();
+
+    //border faces depend on the attached neighbors' cells
+    for(size_t face=0; face<6; ++face)
+        cacheKey.neighborRevisions[face]=neighbors[face]?neighbors[face]->getRevision():0;
+
+    mesh->setTextureAtlas(faceTable->getTextureAtlas());
+
+    SharedChunkTextureMesh cachedMesh=m_meshCache.find(cacheKey);
+
+    if(cachedMesh)
+    {
+        mesh->share(cachedMesh);
+        return true;
+    }
+
+    m_threadScratchMesh.clear();
+    m_threadScratchMesh.setTextureAtlas(faceTable->getTextureAtlas());
+    m_threadScratchMesh.setFaceTable(faceTable);
+    m_threadScratchMesh.setIndexMode(m_sharedQuadIndices?ChunkTextureMesh::IndexMode::Shared:ChunkTextureMesh::IndexMode::Mesh);
+    //buffers circulate between the scratch and the mesh pool, keep them at a working size
+    m_threadScratchMesh.reserve(ScratchMeshVertices, m_sharedQuadIndices?0:ScratchMeshIndices);
 
 #ifdef DEBUG_ALLOCATION
     Log::debug("SimpleRenderer::buildMesh renderer:%llx hash:(%d, %d) accessing chunk data:%llx", this, renderer->getRegionHash(), renderer->getChunkHash(), chunk);
@@ -1222,7 +1359,11 @@ bool SimpleRenderer<_Grid>::buildMesh(process::Request *request)
     //    else
     MEMORY_CHECK
 
-    voxigen::buildCubicMesh(m_threadScratchMesh, chunk);
+    voxigen::buildMesh(m_meshBuilder, m_threadScratchMesh, chunk);
+
+    //layered meshes keep their layer order for updateLayeredMesh
+    if(m_faceGroups&&(m_meshBuilder!=MeshBuilder::Layered))
+        m_threadScratchMesh.groupFaces();
 
     MEMORY_CHECK
 
@@ -1230,17 +1371,20 @@ bool SimpleRenderer<_Grid>::buildMesh(process::Request *request)
     Log::debug("SimpleRenderer::buildMesh renderer:%llx hash:(%d, %d) access complete:%llx", this, renderer->getRegionHash(), renderer->getChunkHash(), chunk);
 #endif
 
-    std::vector<ChunkTextureMesh::Vertex> &vertexes=m_threadScratchMesh.getVertexes();
-    std::vector<int> &indexes=m_threadScratchMesh.getIndexes();
-
-    //copy from scratch to allocated mesh
-    std::vector<ChunkTextureMesh::Vertex> &meshVertexes=mesh->getVertexes();
-    std::vector<int> &meshIndexes=mesh->getIndexes();
+    if(m_meshCache.capacity()>0)
+    {
+        //the mesh and the cache share one compact copy of the built buffers
+        std::shared_ptr<ChunkTextureMesh> builtMesh=std::make_shared<ChunkTextureMesh>();
 
-    meshVertexes.resize(vertexes.size());
-    memcpy(meshVertexes.data(), vertexes.data(), vertexes.size()*sizeof(ChunkTextureMesh::Vertex));
-    meshIndexes.resize(indexes.size());
-    memcpy(meshIndexes.data(), indexes.data(), indexes.size()*sizeof(int));
+        builtMesh->copy(m_threadScratchMesh);
+        mesh->share(builtMesh);
+        m_meshCache.insert(cacheKey, builtMesh);
+    }
+    else
+    {
+        //hand the built buffers to the mesh, scratch takes the mesh's old buffers
+        mesh->swap(m_threadScratchMesh);
+    }
 
     MEMORY_CHECK
 
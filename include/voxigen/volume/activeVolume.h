@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <functional>
+#include <unordered_map>
 
 namespace voxigen
 {
@@ -82,6 +83,8 @@ public:
     typedef ChunkTextureMesh Mesh;
     typedef MeshUpdate<ChunkContainer, Mesh> MeshUpdate;
     typedef std::vector<MeshUpdate> MeshUpdates;
+
+    typedef typename Grid::CellType Cell;
 //    typedef std::function<_Container *()> GetContainer;
 //    typedef std::function<void (_Container *)> ReleaseContainer;
 
@@ -101,6 +104,13 @@ public:
     void updatePosition(const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex);
 
     void update(MeshUpdates &loadedMeshes, MeshUpdates &releaseMeshes);
+
+    //edits a cell (index in the chunk's lod cells) of a loaded chunk, the chunk and the neighbors
+    //sharing an edited border are remeshed on the next update. Fails if the chunk is not loaded,
+    //is empty or a mesh is reading it, the edit can be tried again next update
+    bool setCell(const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex, const glm::ivec3 &cellIndex, const Cell &cell);
+    //face table for the meshes updated in place after edits, owned by the renderer
+    void setFaceTable(const Mesh::FaceTable *faceTable) { m_faceTable=faceTable; }
 //    void updateRegions(RegionContainers &newContainers, ChunkContainers &releasedContainers);
 //    void updateChunks(RegionContainers &newRegionContainers, ChunkContainers &newChunkContainers);
 //    void updateRegions(RegionContainers &newRegionContainers, ChunkContainers &newChunkContainers);
@@ -130,14 +140,27 @@ public:
 private:
     void updateChunkVolume();
 
+    void returnMeshes(MeshUpdates &releaseMeshes);
+    void releaseMesh(Mesh *mesh);
     void releaseContainers();
     void updateRegions();
     void updateChunks();
-    void updateMeshes(MeshUpdates &loadedMeshes, MeshUpdates &releaseMeshes);
+    void updateMeshes(MeshUpdates &loadedMeshes);
     void completeMeshRequest(process::Request *request, MeshUpdates &loadedMeshes);
     bool requestChunkContainerMesh(_ChunkContainer *container);
+    void sendMeshRequest(ChunkContainer *container, SharedChunkHandle &handle, Mesh *mesh);
     void generateMeshRequest();
 
+    //neighbors used to cull the chunk border faces
+    SharedChunkHandle getMeshNeighbor(const RegionChunkIndex &index, size_t face, size_t lod);
+    void attachMeshNeighbors(ChunkContainer *container, SharedChunkHandle &handle);
+    void detachMeshNeighbors(ChunkContainer *container);
+    void queueNeighborRemesh(const RegionChunkIndex &index);
+    bool needsRemesh(ChunkContainer *container);
+    void updateRemesh();
+    void queueEdit(ChunkContainer *container);
+    void updateEdits();
+
     Grid *m_grid;
     const Descriptor *m_descriptors;
 
@@ -152,6 +175,14 @@ private:
     RequestQueue m_completedRequests;
 
     ChunkContainers m_chunkMeshQueue;
+    //meshed containers to check for neighbors that arrived after they were meshed
+    ChunkContainers m_chunkRemeshQueue;
+    //edited containers waiting to be remeshed
+    ChunkContainers m_chunkEditQueue;
+    //edited containers keep their uploaded (layered) mesh so later edits only remesh the
+    //changed layers, null until the next mesh is uploaded
+    std::unordered_map<ChunkContainer *, Mesh *> m_editMeshes;
+    const Mesh::FaceTable *m_faceTable;
 
     RegionIndex m_regionIndex;
     RegionChunkIndex m_chunkIndex;
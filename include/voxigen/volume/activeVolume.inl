@@ -41,6 +41,7 @@ m_chunkVolume(grid, descriptors,
     std::bind(&ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::initChunkVolumeInfo, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3),
     std::bind(&ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::getChunkContainer, this), 
     std::bind(&ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::releaseChunkContainer, this, std::placeholders::_1)),
+m_faceTable(nullptr),
 m_loadedChunks(0),
 m_loadingChunks(0),
 m_meshingChunks(0)
@@ -165,11 +166,13 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::releaseChunkContain
     m_releaseChunkContainers.push_back(container); //store to check later
 }
 
-//template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
-//void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::releaseMesh(Mesh *mesh)
-//{
-//    m_chunkMeshes.release(mesh);
-//}
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::releaseMesh(Mesh *mesh)
+{
+    //drop any mesh cache entry the mesh shares, the pool keeps only its own buffers
+    mesh->clear();
+    m_chunkMeshes.release(mesh);
+}
 
 template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
 void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::initRegionVolumeInfo(std::vector<RegionContainerInfo> &volume, glm::ivec3 &volumeSize, glm::ivec3 &volumeCenter)
@@ -256,10 +259,13 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunkVolume()
 {
         m_chunkVolume.update(m_chunkIndex, m_chunkLoadRequests, m_chunkUpdates);
 
-        size_t processedLoads=0;
+        //requests that have to wait are moved down to keptLoads and kept for the next update
+        size_t keptLoads=0;
+        size_t loadIndex=0;
 
-        for(ChunkLoadContainer &loadRequest:m_chunkLoadRequests)
+        for(; loadIndex<m_chunkLoadRequests.size(); ++loadIndex)
         {
+            ChunkLoadContainer &loadRequest=m_chunkLoadRequests[loadIndex];
             ChunkContainer *container=loadRequest.container;
 
             if(container->getAction() == RenderAction::Idle)
@@ -272,8 +278,7 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunkVolume()
 #ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
                     Log::debug("ActiveVolume::updateChunkVolume - Chunk container(%llx, %llx) request load handle invalid - %s", container, 0, container->getActionString().c_str());
 #endif
-                    processedLoads++;//act like we processed it
-                    continue;
+                    continue;//act like we processed it
                 }
 
                 HandleState chunkState=chunkHandle->getState();
@@ -293,6 +298,13 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunkVolume()
 
                 if(loadHandle)
                 {
+                    //a neighbor mesh is reading the chunk, try it again next update and carry on
+                    if(chunkHandle->inUse())
+                    {
+                        m_chunkLoadRequests[keptLoads++]=loadRequest;
+                        continue;
+                    }
+
 #ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
                     Log::debug("ActiveVolume::updateChunkVolume - Chunk container(%llx, %llx) request load - %s", container, container->getKey().hash, container->getActionString().c_str());
 #endif
@@ -303,7 +315,6 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunkVolume()
 #endif
                         break;
                     }
-                    processedLoads++;
                     m_loadingChunks++;
                 }
                 else
@@ -311,7 +322,7 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunkVolume()
 #ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
                     Log::debug("ActiveVolume::updateChunkVolume - Chunk container(%llx, %llx) failed to request load, already loaded - %s", container, container->getKey().hash, container->getActionString().c_str());
 #endif
-                    processedLoads++;//act like we processed it
+                    //act like we processed it
                 }
             }
             else
@@ -319,14 +330,16 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunkVolume()
 #ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
                 Log::debug("ActiveVolume::updateChunkVolume - Chunk container(%llx, %llx) failed to request load, container busy - %s", container, container->getKey().hash, container->getActionString().c_str());
 #endif
-                processedLoads++;//act like we processed it
+                //act like we processed it
             }
         }
 
-        if(processedLoads == m_chunkLoadRequests.size())
-            m_chunkLoadRequests.clear();
-        else
-            m_chunkLoadRequests.erase(m_chunkLoadRequests.begin(), m_chunkLoadRequests.begin()+processedLoads);
+        //out of requests stops the loop, everything from loadIndex is kept as well
+        size_t remainingLoads=m_chunkLoadRequests.size()-loadIndex;
+
+        if(keptLoads!=loadIndex)
+            std::move(m_chunkLoadRequests.begin()+loadIndex, m_chunkLoadRequests.end(), m_chunkLoadRequests.begin()+keptLoads);
+        m_chunkLoadRequests.resize(keptLoads+remainingLoads);
 
         typename _Grid::DescriptorType &descriptors=m_grid->getDescriptors();
 
@@ -348,6 +361,9 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::update(MeshUpdates
 {
     m_grid->getUpdated(m_updatedRegions, m_updatedChunks, m_completedRequests);
 
+    //before the containers they belong to are released and reused
+    returnMeshes(releaseMeshes);
+
     releaseContainers();
 
     updateRegions();
@@ -356,7 +372,35 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::update(MeshUpdates
 
     updateChunkVolume();
 
-    updateMeshes(loadedMeshes, releaseMeshes);
+    updateMeshes(loadedMeshes);
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::returnMeshes(MeshUpdates &releaseMeshes)
+{
+    //return all released meshes, edited containers keep theirs
+    for(size_t i=0; i<releaseMeshes.size(); ++i)
+    {
+        MeshUpdate &update=releaseMeshes[i];
+        auto editMesh=m_editMeshes.find(update.container);
+
+        if(editMesh!=m_editMeshes.end())
+        {
+            if(editMesh->second&&(editMesh->second!=update.mesh))
+                releaseMesh(editMesh->second);
+            editMesh->second=nullptr;
+
+            //only layered meshes can be updated in place
+            if(update.mesh->hasLayers())
+            {
+                editMesh->second=update.mesh;
+                continue;
+            }
+        }
+
+        releaseMesh(update.mesh);
+    }
+    releaseMeshes.clear();
 }
 
 template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
@@ -371,6 +415,16 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::releaseContainers()
 #ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
             Log::debug("ActiveVolume::releaseContainers - Chunk container(%llx, %llx) release - %s", chunkContainer, chunkContainer->getKey().hash, chunkContainer->getActionString().c_str());
 #endif
+            auto editMesh=m_editMeshes.find(chunkContainer);
+
+            if(editMesh!=m_editMeshes.end())
+            {
+                if(editMesh->second)
+                    releaseMesh(editMesh->second);
+                m_editMeshes.erase(editMesh);
+            }
+            m_chunkEditQueue.erase(std::remove(m_chunkEditQueue.begin(), m_chunkEditQueue.end(), chunkContainer), m_chunkEditQueue.end());
+
             chunkContainer->release();
             m_chunkContainers.release(chunkContainer);
 
@@ -439,6 +493,9 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunks()
                     containerInfo->container->getActionString().c_str());
 #endif
                 m_chunkMeshQueue.push_back(container);
+
+                if(!container->getHandle()->empty())
+                    queueNeighborRemesh(index);
             }
             else
             {
@@ -463,15 +520,8 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateChunks()
 }
 
 template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
-void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateMeshes(MeshUpdates &loadedMeshes, MeshUpdates &releaseMeshes)
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateMeshes(MeshUpdates &loadedMeshes)
 {
-    //return all released meshes
-    for(size_t i=0; i<releaseMeshes.size(); ++i)
-    {
-        m_chunkMeshes.release(releaseMeshes[i].mesh);
-    }
-    releaseMeshes.clear();
-
     for(size_t i=0; i<m_completedRequests.size(); ++i)
     {
         process::Request *request=m_completedRequests[i];
@@ -496,6 +546,8 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateMeshes(MeshUp
     }
     m_completedRequests.clear();
 
+    updateRemesh();
+    updateEdits();
     generateMeshRequest();
 }
 
@@ -505,6 +557,8 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::completeMeshRequest
     ChunkContainer *container=(ChunkContainer *)request->data.buildMesh.renderer;
     Mesh *mesh=(Mesh *)request->data.buildMesh.mesh;
 
+    detachMeshNeighbors(container);
+
     //updated chunks just need to swap out the mesh as that is all that should have been changed
 #ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
     glm::ivec3 regionIndex=container->getRegionIndex();
@@ -532,7 +586,7 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::completeMeshRequest
         container->setAction(RenderAction::Idle); //renderer is idle again, make sure it can be cleaned up
 
 //        getProcessThread().returnMesh(container, request->data.buildMesh.mesh);
-        m_chunkMeshes.release(mesh);
+        releaseMesh(mesh);
 
 //#ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
 //        Log::debug("ActiveVolume::completeMeshRequest - release request %llx", request);
@@ -561,6 +615,9 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::completeMeshRequest
     
     loadedMeshes.emplace_back(container, mesh);
     m_meshingChunks--;
+
+    //a neighbor may have arrived while meshing
+    m_chunkRemeshQueue.push_back(container);
 }
 
 template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
@@ -608,13 +665,21 @@ bool ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::requestChunkContain
 #ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
     Log::debug("ActiveVolume::requestChunkContainerMesh - Chunk container(%llx, %llx) request mesh - %s", container, container->getKey().hash, container->getActionString().c_str());
 #endif
+    container->clearMeshUpdate();
+    sendMeshRequest(container, handle, mesh);
+    return true;
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::sendMeshRequest(ChunkContainer *container, SharedChunkHandle &handle, Mesh *mesh)
+{
     container->setAction(RenderAction::Meshing);
     container->setMeshState(MeshState::Meshing);
     m_meshingChunks++;
     handle->addInUse();
+    attachMeshNeighbors(container, handle);
 
     getProcessThread().requestChunkMesh(container, mesh);
-    return true;
 }
 
 template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
@@ -638,4 +703,296 @@ void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::generateMeshRequest
         m_chunkMeshQueue.erase(m_chunkMeshQueue.begin(), m_chunkMeshQueue.begin()+count);
 }
 
-}//namespace voxigen
\ No newline at end of file
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+typename ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::SharedChunkHandle ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::getMeshNeighbor(const RegionChunkIndex &index, size_t face, size_t lod)
+{
+    glm::ivec3 delta(0, 0, 0);
+
+    delta[face/2]=((face&1)!=0)?1:-1;
+
+    RegionChunkIndex neighborIndex=RegionChunkIndex::offset(m_grid, index, delta);
+    ChunkContainerInfo *containerInfo=m_chunkVolume.getContainerInfo(neighborIndex);
+
+    if((containerInfo==nullptr)||(containerInfo->container==nullptr))
+        return SharedChunkHandle();
+
+    SharedChunkHandle handle=containerInfo->container->getHandle();
+
+    if(!handle)
+        return SharedChunkHandle();
+
+    //only neighbors with data at the same lod, busy handles may swap their data
+    if((handle->getState()!=HandleState::Memory)||(handle->action()!=HandleAction::Idle))
+        return SharedChunkHandle();
+    if(handle->empty()||(handle->chunk()==nullptr)||(handle->getLod()!=lod))
+        return SharedChunkHandle();
+
+    return handle;
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::attachMeshNeighbors(ChunkContainer *container, SharedChunkHandle &handle)
+{
+    typename Grid::Chunk *chunk=handle->chunk();
+
+    if(!chunk)
+        return;
+
+    RegionChunkIndex index;
+
+    index.region=container->getRegionIndex();
+    index.chunk=container->getChunkIndex();
+
+    std::array<SharedChunkHandle, 6> &neighbors=container->getMeshNeighbors();
+    unsigned int mask=0;
+
+    for(size_t face=0; face<6; ++face)
+    {
+        SharedChunkHandle neighbor=getMeshNeighbor(index, face, handle->getLod());
+
+        if(neighbor)
+        {
+            //hold the neighbor data until the mesh completes
+            neighbor->addInUse();
+            chunk->setNeighbor(face, neighbor->chunk());
+            mask|=(1<<face);
+        }
+        else
+            chunk->setNeighbor(face, nullptr);
+
+        neighbors[face]=neighbor;
+    }
+
+    container->setMeshNeighborMask(mask);
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::detachMeshNeighbors(ChunkContainer *container)
+{
+    std::array<SharedChunkHandle, 6> &neighbors=container->getMeshNeighbors();
+
+    for(SharedChunkHandle &neighbor:neighbors)
+    {
+        if(!neighbor)
+            continue;
+
+        //data stays with the neighbor, its own container handles the release
+        neighbor->removeInUse();
+        neighbor.reset();
+    }
+
+    SharedChunkHandle handle=container->getHandle();
+
+    if(handle && handle->chunk())
+        handle->chunk()->clearNeighbors();
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::queueNeighborRemesh(const RegionChunkIndex &index)
+{
+    for(size_t face=0; face<6; ++face)
+    {
+        glm::ivec3 delta(0, 0, 0);
+
+        delta[face/2]=((face&1)!=0)?1:-1;
+
+        RegionChunkIndex neighborIndex=RegionChunkIndex::offset(m_grid, index, delta);
+        ChunkContainerInfo *containerInfo=m_chunkVolume.getContainerInfo(neighborIndex);
+
+        if((containerInfo==nullptr)||(containerInfo->container==nullptr)||!containerInfo->mesh)
+            continue;
+
+        ChunkContainer *container=containerInfo->container;
+
+        //not meshed yet, it will pick up the neighbor when it is
+        if(container->getMeshState()==MeshState::Invalid)
+            continue;
+
+        if(std::find(m_chunkRemeshQueue.begin(), m_chunkRemeshQueue.end(), container)==m_chunkRemeshQueue.end())
+            m_chunkRemeshQueue.push_back(container);
+    }
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+bool ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::needsRemesh(ChunkContainer *container)
+{
+    SharedChunkHandle handle=container->getHandle();
+
+    if(!handle||handle->empty()||(container->getMeshState()!=MeshState::Ready))
+        return false;
+
+    RegionChunkIndex index;
+
+    index.region=container->getRegionIndex();
+    index.chunk=container->getChunkIndex();
+
+    ChunkContainerInfo *containerInfo=m_chunkVolume.getContainerInfo(index);
+
+    //container was released or moved
+    if((containerInfo==nullptr)||(containerInfo->container!=container)||!containerInfo->mesh)
+        return false;
+
+    unsigned int mask=container->getMeshNeighborMask();
+
+    for(size_t face=0; face<6; ++face)
+    {
+        if((mask&(1<<face))!=0)
+            continue;
+
+        if(getMeshNeighbor(index, face, handle->getLod()))
+            return true;
+    }
+    return false;
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateRemesh()
+{
+    for(size_t i=0; i<m_chunkRemeshQueue.size(); )
+    {
+        ChunkContainer *container=m_chunkRemeshQueue[i];
+
+        //still meshing/uploading, check again once idle
+        if(container->getAction()!=RenderAction::Idle)
+        {
+            ++i;
+            continue;
+        }
+
+        if(needsRemesh(container))
+        {
+#ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
+            Log::debug("ActiveVolume::updateRemesh - Chunk container(%llx, %llx) neighbor arrived, remeshing - %s", container, container->getKey().hash, container->getActionString().c_str());
+#endif
+            m_chunkMeshQueue.push_back(container);
+        }
+
+        //erase container by swapping with back and popping
+        m_chunkRemeshQueue[i]=m_chunkRemeshQueue.back();
+        m_chunkRemeshQueue.pop_back();
+    }
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+bool ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::setCell(const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex, const glm::ivec3 &cellIndex, const Cell &cell)
+{
+    RegionChunkIndex index;
+
+    index.region=regionIndex;
+    index.chunk=chunkIndex;
+
+    ChunkContainerInfo *containerInfo=m_chunkVolume.getContainerInfo(index);
+
+    if((containerInfo==nullptr)||(containerInfo->container==nullptr))
+        return false;
+
+    ChunkContainer *container=containerInfo->container;
+    SharedChunkHandle handle=container->getHandle();
+
+    if(!handle||(handle->getState()!=HandleState::Memory)||!handle->chunk())
+        return false;
+
+    //a mesh (its own or a neighbor's) is reading the cells
+    if(handle->inUse())
+        return false;
+
+    typename Grid::Chunk *chunk=handle->chunk();
+    glm::ivec3 size=handle->size()/glm::ivec3(1<<(int)chunk->getLod());
+
+    for(size_t axis=0; axis<3; ++axis)
+    {
+        if((cellIndex[axis]<0)||(cellIndex[axis]>=size[axis]))
+            return false;
+    }
+
+    chunk->setCell(cellIndex, cell);
+
+    m_editMeshes.emplace(container, nullptr);
+    queueEdit(container);
+
+    //neighbors mesh against the cells on the shared border
+    for(size_t face=0; face<6; ++face)
+    {
+        size_t axis=face/2;
+        bool positive=((face&1)!=0);
+
+        if(cellIndex[axis]!=(positive?size[axis]-1:0))
+            continue;
+
+        glm::ivec3 delta(0, 0, 0);
+
+        delta[axis]=positive?1:-1;
+
+        RegionChunkIndex neighborIndex=RegionChunkIndex::offset(m_grid, index, delta);
+        ChunkContainerInfo *neighborInfo=m_chunkVolume.getContainerInfo(neighborIndex);
+
+        if((neighborInfo==nullptr)||(neighborInfo->container==nullptr)||!neighborInfo->mesh)
+            continue;
+
+        //not meshed yet, it will see the edit when it is
+        if(neighborInfo->container->getMeshState()==MeshState::Invalid)
+            continue;
+
+        queueEdit(neighborInfo->container);
+    }
+    return true;
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::queueEdit(ChunkContainer *container)
+{
+    if(std::find(m_chunkEditQueue.begin(), m_chunkEditQueue.end(), container)==m_chunkEditQueue.end())
+        m_chunkEditQueue.push_back(container);
+}
+
+template<typename _Grid, typename _ChunkContainer, typename _RegionContainer>
+void ActiveVolume<_Grid, _ChunkContainer, _RegionContainer>::updateEdits()
+{
+    for(size_t i=0; i<m_chunkEditQueue.size(); )
+    {
+        ChunkContainer *container=m_chunkEditQueue[i];
+        SharedChunkHandle handle=container->getHandle();
+
+        //still meshing/uploading or a neighbor mesh is reading the chunk, check again later
+        if((container->getAction()!=RenderAction::Idle)||(handle&&handle->inUse()))
+        {
+            ++i;
+            continue;
+        }
+
+        //erase container by swapping with back and popping
+        m_chunkEditQueue[i]=m_chunkEditQueue.back();
+        m_chunkEditQueue.pop_back();
+
+        if(!handle||(handle->getState()!=HandleState::Memory)||!handle->chunk())
+            continue;
+
+        typename Grid::Chunk *chunk=handle->chunk();
+        auto editMesh=m_editMeshes.find(container);
+        Mesh *mesh=(editMesh!=m_editMeshes.end())?editMesh->second:nullptr;
+
+        if(!mesh||!chunk->isDirty()||(m_faceTable==nullptr))
+        {
+            //nothing to update in place (or a neighbor's border changed), mesh the whole chunk.
+            //Edits are packed here as the mesh threads only read the chunk
+            if(chunk->isDirty())
+                chunk->clearDirty();
+            m_chunkMeshQueue.push_back(container);
+            continue;
+        }
+
+#ifdef VOXIGEN_DEBUG_ACTIVEVOLUME
+        Log::debug("ActiveVolume::updateEdits - Chunk container(%llx, %llx) updating edited layers - %s", container, container->getKey().hash, container->getActionString().c_str());
+#endif
+        //the mesh threads rebuild only the edited layers of the kept mesh, edits are packed
+        //here as they only read the chunk
+        container->setMeshUpdate(chunk->getDirtyMin(), chunk->getDirtyMax());
+        chunk->clearDirty();
+
+        //handed back through returnMeshes once uploaded
+        editMesh->second=nullptr;
+        sendMeshRequest(container, handle, mesh);
+    }
+}
+
+}//namespace voxigen
@@ -4,10 +4,15 @@
 #include "voxigen/defines.h"
 //#include "voxigen/boundingBox.h"
 #include "voxigen/volume/gridDescriptors.h"
+#include "voxigen/volume/chunkStorage.h"
 
 #include <vector>
+#include <algorithm>
 #include <memory>
 #include <type_traits>
+#include <cassert>
+#include <cstring>
+#include <limits>
 
 #ifdef DEBUG_ALLOCATION
 #include "voxigen/fileio/log.h"
@@ -16,15 +21,17 @@
 namespace voxigen
 {
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage=DenseStorage<_Cell>>
 class Chunk//:public BoundingBox
 {
 public:
     Chunk();
-    Chunk(ChunkHash hash, unsigned int revision, const glm::ivec3 &index, glm::vec3 gridOffset, size_t lod);
+    Chunk(ChunkHash hash, unsigned int revision, const glm::ivec3 &index, glm::vec3 gridOffset, size_t lod, bool allocate=true);
     ~Chunk();
 
-    typedef std::vector<_Cell> Cells;
+    typedef _Storage StorageType;
+    typedef typename _Storage::Cells Cells;
+    typedef typename _Storage::View CellViewType;
     typedef _Cell CellType;
     typedef std::integral_constant<size_t, _x> sizeX;
     typedef std::integral_constant<size_t, _y> sizeY;
@@ -34,7 +41,28 @@ public:
     void allocate(size_t lod);
 
     ChunkHash getHash() const { return m_hash; }
-    Cells &getCells() { return m_cells; }
+    //mutable access, if the chunk is a view, packed or uniform the cells are expanded first (copy on write)
+    Cells &getCells() { if(m_uniform) expandUniform(); return m_storage.getCells(); }
+    //read only access, does not force a copy, not valid for uniform chunks (check isUniform first)
+    CellViewType getCellView() const { assert(!m_uniform); return m_storage.getView(); }
+
+    //single cell type for the whole chunk, no cells are stored
+    bool isUniform() const { return m_uniform; }
+    const _Cell &getUniformCell() const { return m_uniformCell; }
+    void setUniform(const _Cell &cell);
+
+    //compresses cells if the storage supports it, called once the cells are filled
+    //chunks found to be a single cell type are converted to uniform
+    void pack();
+    //cells in storage format, used for writing to disk
+    const char *getData(size_t &size, uint32_t &encoding);
+    //copies cells from storage format
+    bool setData(const char *data, size_t size, uint32_t encoding);
+
+    //use external memory for the cells, owner keeps the memory alive
+    bool setView(const char *data, size_t size, uint32_t encoding, std::shared_ptr<void> owner);
+    bool isView() const { return m_storage.isView(); }
+    size_t memoryUsed() const { return m_storage.memoryUsed(); }
     
     unsigned int validCellCount() { return m_validCells; }
     void setValidCellCount(unsigned int count) { m_validCells=count; }
@@ -43,16 +71,40 @@ public:
     const glm::vec3 &getGridOffset() const { return m_gridOffset; }
     size_t getLod() { return m_lod; }
 
-    _Cell &getCell(const glm::vec3 &position);
+    //cell index (lod cells) of a position inside the chunk
+    glm::ivec3 getCellIndex(const glm::vec3 &position) const;
+    //read only, uniform and viewed/packed chunks are read in place (use setCell to change a cell)
+    _Cell getCell(const glm::vec3 &position) const;
 
+    //edits a cell by cell index (lod cells), the revision is incremented and the cell
+    //added to the dirty box so only the changed part has to be remeshed
+    void setCell(const glm::ivec3 &cellIndex, const _Cell &cell);
+    //for cells changed through getCells, min/max inclusive in lod cells
+    void markDirty(const glm::ivec3 &min, const glm::ivec3 &max);
+    unsigned int getRevision() const { return m_revision; }
+    bool isDirty() const { return m_dirtyMin.x<=m_dirtyMax.x; }
+    const glm::ivec3 &getDirtyMin() const { return m_dirtyMin; }
+    const glm::ivec3 &getDirtyMax() const { return m_dirtyMax; }
+    //called once the changes have been meshed, repacks the storage (references from
+    //getCells/getCell are invalid afterwards)
+    void clearDirty();
+
+    //neighbors follow the faces indexing, 0:-x, 1:+x, 2:-y, 3:+y, 4:-z, 5:+z
     bool hasNeighbors() { return m_hasNeighbors; }
     std::vector<Chunk *> &getNeighbors() { return m_neighbors; }
+    void setNeighbor(size_t face, Chunk *neighbor);
+    void clearNeighbors();
 
 private:
+    size_t cellCount() const { return (_x*_y*_z)/(m_lod+1); }
+    void expandUniform();
+
     ChunkHash m_hash; //unique id used to look up chunk in region
     unsigned int m_revision; //incremented as changes are made
 
-    Cells m_cells; //block info
+    _Storage m_storage; //block info
+    bool m_uniform; //all cells are m_uniformCell, m_storage is empty
+    _Cell m_uniformCell;
     glm::ivec3 m_index; //grid index
     glm::vec3 m_gridOffset; //offset in grid coords
     size_t m_lod;
@@ -60,84 +112,255 @@ private:
 
     bool m_hasNeighbors;
     std::vector<Chunk *> m_neighbors;
+
+    //cells changed since the last clearDirty, empty when min>max
+    glm::ivec3 m_dirtyMin;
+    glm::ivec3 m_dirtyMax;
 };
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
-using UniqueChunk=std::unique_ptr<Chunk<_Cell, _x, _y, _z>>;
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage=DenseStorage<_Cell>>
+using UniqueChunk=std::unique_ptr<Chunk<_Cell, _x, _y, _z, _Storage>>;
 
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
-Chunk<_Cell, _x, _y, _z>::Chunk():
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+Chunk<_Cell, _x, _y, _z, _Storage>::Chunk():
     m_hash(0),
     m_revision(0),
+    m_uniform(false),
     m_validCells(0),
     m_lod(0),
     m_hasNeighbors(false),
-    m_neighbors(9)
+    m_neighbors(6),
+    m_dirtyMin(std::numeric_limits<int>::max()),
+    m_dirtyMax(-1)
 {
 }
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
-Chunk<_Cell, _x, _y, _z>::Chunk(ChunkHash hash, unsigned int revision, const glm::ivec3 &index, glm::vec3 gridOffset, size_t lod):
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+Chunk<_Cell, _x, _y, _z, _Storage>::Chunk(ChunkHash hash, unsigned int revision, const glm::ivec3 &index, glm::vec3 gridOffset, size_t lod, bool allocate):
     //BoundingBox(dimensions, transform),
     m_hash(hash),
     m_revision(revision),
+    m_uniform(false),
     m_index(index),
     m_gridOffset(gridOffset),
     m_validCells(0),
     m_lod(lod),
     m_hasNeighbors(false),
-    m_neighbors(9)
+    m_neighbors(6),
+    m_dirtyMin(std::numeric_limits<int>::max()),
+    m_dirtyMax(-1)
 {
     size_t size=(_x*_y*_z)/(lod+1);
-    m_cells.resize(size);
+
+    if(allocate)
+        m_storage.allocate(size);
 
     MEMORY_CHECK
     std::fill(m_neighbors.begin(), m_neighbors.end(), nullptr);
     MEMORY_CHECK
     
 #ifdef DEBUG_ALLOCATION
-    Log::debug("Chunk::Chunk %llx hash:%d allocate cells - data %llx size %d\n", this, m_hash, m_cells.data(), size);
+    Log::debug("Chunk::Chunk %llx hash:%d allocate cells - size %d\n", this, m_hash, size);
 #endif
 }
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
-Chunk<_Cell, _x, _y, _z>::~Chunk()
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+Chunk<_Cell, _x, _y, _z, _Storage>::~Chunk()
 {
 #ifdef DEBUG_ALLOCATION
-    Log::debug("Chunk::~Chunk %llx hash:%d  free cells - data %llx\n", this, m_hash, m_cells.data());
+    Log::debug("Chunk::~Chunk %llx hash:%d  free cells - memory %d\n", this, m_hash, m_storage.memoryUsed());
 #endif
 };
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
-void Chunk<_Cell, _x, _y, _z>::setChunk(ChunkHash hash, const glm::ivec3 &index, const glm::vec3 gridOffset)
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::setChunk(ChunkHash hash, const glm::ivec3 &index, const glm::vec3 gridOffset)
 {
     m_hash=hash;
     m_index=index;
     m_gridOffset=gridOffset;
 }
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
-void Chunk<_Cell, _x, _y, _z>::allocate(size_t lod)
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::setNeighbor(size_t face, Chunk *neighbor)
+{
+    m_neighbors[face]=neighbor;
+    m_hasNeighbors=std::any_of(m_neighbors.begin(), m_neighbors.end(), [](Chunk *chunk) { return chunk!=nullptr; });
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::clearNeighbors()
+{
+    std::fill(m_neighbors.begin(), m_neighbors.end(), nullptr);
+    m_hasNeighbors=false;
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::allocate(size_t lod)
 {
     m_lod=lod;
     size_t size=(_x*_y*_z)/(m_lod+1);
-    m_cells.resize(size);
+
+    m_uniform=false;
+    m_storage.allocate(size);
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::setUniform(const _Cell &cell)
+{
+    m_uniform=true;
+    m_uniformCell=cell;
+    m_storage.clear();
 }
 
-template<typename _Cell, size_t _x, size_t _y, size_t _z>
-_Cell &Chunk<_Cell, _x, _y, _z>::getCell(const glm::vec3 &position)
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::expandUniform()
 {
-    size_t lod=m_lod+1;
-    size_t x=_x/lod;
-    size_t y=_y/lod;
+#ifdef DEBUG_ALLOCATION
+    Log::debug("Chunk::expandUniform %llx hash:%d expanding uniform chunk\n", this, m_hash);
+#endif
+    m_uniform=false;
+    m_storage.allocate(cellCount());
+
+    Cells &cells=m_storage.getCells();
+
+    std::fill(cells.begin(), cells.end(), m_uniformCell);
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::pack()
+{
+    if(m_uniform)
+        return;
+
+    CellViewType view=m_storage.getView();
 
-    glm::ivec3 cellPos=glm::ivec3(glm::floor(position))/glm::ivec3(lod);
+    if(view.empty())
+        return;
+
+    //cells are pod, compare as bytes
+    _Cell cell=view[0];
+    size_t count=view.size();
+    size_t i=1;
+
+    for(; i<count; ++i)
+    {
+        _Cell nextCell=view[i];
+
+        if(memcmp(&nextCell, &cell, sizeof(_Cell))!=0)
+            break;
+    }
+
+    if(i==count)
+    {
+        setUniform(cell);
+        return;
+    }
+
+    m_storage.pack();
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+const char *Chunk<_Cell, _x, _y, _z, _Storage>::getData(size_t &size, uint32_t &encoding)
+{
+    if(m_uniform)
+    {
+        size=sizeof(_Cell);
+        encoding=CellEncoding::Uniform;
+        return (const char *)&m_uniformCell;
+    }
+    return m_storage.data(size, encoding);
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+bool Chunk<_Cell, _x, _y, _z, _Storage>::setData(const char *data, size_t size, uint32_t encoding)
+{
+    if(encoding==CellEncoding::Uniform)
+    {
+        if(size!=sizeof(_Cell))
+            return false;
+
+        _Cell cell;
+
+        memcpy(&cell, data, sizeof(_Cell));
+        setUniform(cell);
+        return true;
+    }
+
+    m_uniform=false;
+    return m_storage.load(data, size, encoding, cellCount());
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+bool Chunk<_Cell, _x, _y, _z, _Storage>::setView(const char *data, size_t size, uint32_t encoding, std::shared_ptr<void> owner)
+{
+#ifdef DEBUG_ALLOCATION
+    Log::debug("Chunk::setView %llx hash:%d view %llx size %d\n", this, m_hash, data, size);
+#endif
+    //single cell, nothing to view
+    if(encoding==CellEncoding::Uniform)
+        return setData(data, size, encoding);
+
+    m_uniform=false;
+    return m_storage.setView(data, size, encoding, cellCount(), owner);
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+glm::ivec3 Chunk<_Cell, _x, _y, _z, _Storage>::getCellIndex(const glm::vec3 &position) const
+{
+    int stride=1<<m_lod;
+
+    return glm::ivec3(glm::floor(position))/glm::ivec3(stride);
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+_Cell Chunk<_Cell, _x, _y, _z, _Storage>::getCell(const glm::vec3 &position) const
+{
+    if(m_uniform)
+        return m_uniformCell;
+
+    size_t stride=(size_t)1<<m_lod;
+    size_t x=_x/stride;
+    size_t y=_y/stride;
+
+    glm::ivec3 cellPos=getCellIndex(position);
     unsigned int index=(x*y)*cellPos.z+x*cellPos.y+cellPos.x;
+    CellViewType cells=getCellView();
+
+    assert(index<cells.size());
+    return cells[index];
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::setCell(const glm::ivec3 &cellIndex, const _Cell &cell)
+{
+    size_t stride=(size_t)1<<m_lod;
+    size_t x=_x/stride;
+    size_t y=_y/stride;
 
-    assert(index>=0);
-    assert(index<m_cells.size());
-    return m_cells[index];
+    unsigned int index=(x*y)*cellIndex.z+x*cellIndex.y+cellIndex.x;
+    Cells &cells=getCells();
+
+    assert(index<cells.size());
+    cells[index]=cell;
+
+    markDirty(cellIndex, cellIndex);
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::markDirty(const glm::ivec3 &min, const glm::ivec3 &max)
+{
+    m_revision++;
+    m_dirtyMin=glm::min(m_dirtyMin, min);
+    m_dirtyMax=glm::max(m_dirtyMax, max);
+}
+
+template<typename _Cell, size_t _x, size_t _y, size_t _z, typename _Storage>
+void Chunk<_Cell, _x, _y, _z, _Storage>::clearDirty()
+{
+    m_dirtyMin=glm::ivec3(std::numeric_limits<int>::max());
+    m_dirtyMax=glm::ivec3(-1);
+    pack();
 }
 
 } //namespace voxigen
@@ -3,6 +3,7 @@
 
 #include "voxigen/volume/chunk.h"
 #include "voxigen/volume/handleState.h"
+#include "voxigen/volume/regionPack.h"
 #include <memory>
 
 #ifdef DEBUG_ALLOCATION
@@ -20,7 +21,7 @@ namespace voxigen
 
 class Generator;
 
-template<typename _Cell, size_t _ChunkSizeX, size_t _ChunkSizeY, size_t _ChunkSizeZ, size_t _RegionSizeX, size_t _RegionSizeY, size_t _RegionSizeZ, bool _Thread>
+template<typename _Cell, size_t _ChunkSizeX, size_t _ChunkSizeY, size_t _ChunkSizeZ, size_t _RegionSizeX, size_t _RegionSizeY, size_t _RegionSizeZ, bool _Thread, typename _Storage>
 class RegularGrid;
 
 template<typename _Chunk>
@@ -40,6 +41,7 @@ public:
         m_action(HandleAction::Idle),
         m_cachedOnDisk(false), 
         m_empty(false), 
+        m_regionPack(nullptr),
 #ifndef NDEBUG
         m_stateThreadIdSet(false),
         m_actionThreadIdSet(false),
@@ -53,8 +55,14 @@ public:
 
     //these functions are likely called from another thread
     void generate(IGridDescriptors *descriptors, Generator *generator, size_t lod=0);
-    void read(IGridDescriptors *descriptors, const std::string &fileName, size_t lod=0);
-    void write(IGridDescriptors *descriptors, const std::string &fileName, size_t lod=0);
+    //generates the chunks of a column together, the generator shares the 2d work between them
+    static void generateColumn(IGridDescriptors *descriptors, Generator *generator, size_t lod, ChunkHandle **handles, size_t count);
+    bool read(IGridDescriptors *descriptors, RegionPack *pack, size_t lod=0);
+    //zero-copy read, chunk cells view the mapped pack until edited
+    bool readMapped(IGridDescriptors *descriptors, RegionPack *pack, size_t lod=0);
+    bool write(IGridDescriptors *descriptors, RegionPack *pack, size_t lod=0);
+    //builds chunk from a pack payload read elsewhere (async io)
+    bool readData(IGridDescriptors *descriptors, const char *data, size_t size, uint32_t encoding, unsigned int revision, size_t lod=0);
 
     glm::ivec3 size() { return glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value); }
 
@@ -97,6 +105,10 @@ public:
     bool empty() { return m_empty; }
     void setEmpty(bool empty=true) { m_empty=empty; if(empty) { m_memoryUsed=0; /*setState(HandleState::Memory);*/ } }
 
+    //pack file of the region this chunk belongs to, owned by the RegionHandle
+    RegionPack *regionPack() { return m_regionPack; }
+    void setRegionPack(RegionPack *pack) { m_regionPack=pack; }
+
     Key &key() { return m_key; }
 
     ChunkHash hash() { return m_hash; }
@@ -131,10 +143,15 @@ public:
     size_t getInUse() { return m_inUse; }
 
 private:
-    template<typename _Cell, size_t _ChunkSizeX, size_t _ChunkSizeY, size_t _ChunkSizeZ, size_t _RegionSizeX, size_t _RegionSizeY, size_t _RegionSizeZ, bool _Thread>
+    template<typename _Cell, size_t _ChunkSizeX, size_t _ChunkSizeY, size_t _ChunkSizeZ, size_t _RegionSizeX, size_t _RegionSizeY, size_t _RegionSizeZ, bool _Thread, typename _Storage>
     friend class RegularGrid;
     //this has to be done in the process thread, need to ask the grid to do this
     void release();
+
+    //allocates the chunk for generation and returns its world start position
+    glm::vec3 createGenerated(IGridDescriptors *descriptors, size_t lod);
+    //drops empty chunks and packs the rest once the cells are generated
+    void finishGenerated(unsigned int validCells);
     
 /////////////////////////////////////////////////////////
 //status and action are to be only updated by one thread
@@ -156,6 +173,7 @@ private:
     size_t m_memoryUsed;
     bool m_cachedOnDisk;
     bool m_empty;
+    RegionPack *m_regionPack;
 
 #ifndef NDEBUG
     std::thread::id m_stateThreadId;
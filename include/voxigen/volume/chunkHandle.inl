@@ -1,4 +1,4 @@
-#include <fstream>
+#include "voxigen/generators/generator.h"
 
 namespace voxigen
 {
@@ -10,6 +10,87 @@ std::atomic<int> ChunkHandle<_Chunk>::allocated=0;
 
 template<typename _Chunk>
 void ChunkHandle<_Chunk>::generate(IGridDescriptors *descriptors, Generator *generator, size_t lod)
+{
+    glm::vec3 startPos=createGenerated(descriptors, lod);
+
+    if(!m_chunk)
+        return;
+
+    glm::ivec3 chunkSize(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value);
+    typename ChunkType::CellType uniformCell{};
+    unsigned int validCells;
+
+    //all air/all solid chunks are classified without generating or touching the scratch cells
+    if(generator->classifyChunk(startPos, chunkSize, lod, &uniformCell, sizeof(typename ChunkType::CellType), validCells))
+    {
+        if(validCells>0)
+            m_chunk->setUniform(uniformCell);
+    }
+    else
+    {
+        //generate into per thread scratch, cells are only handed to the chunk if
+        //it is not empty or uniform so those never allocate a cell array
+        static thread_local typename ChunkType::Cells scratchCells;
+        size_t cellCount=(ChunkType::sizeX::value*ChunkType::sizeY::value*ChunkType::sizeZ::value)/(lod+1);
+        bool uniform=false;
+
+        scratchCells.resize(cellCount);
+
+        validCells=generator->generateChunk(startPos, chunkSize, scratchCells.data(), scratchCells.size()*sizeof(typename ChunkType::CellType), lod, uniform);
+
+        if(validCells>0)
+        {
+            if(uniform)
+                m_chunk->setUniform(scratchCells[0]);
+            else
+                m_chunk->getCells().swap(scratchCells);
+        }
+    }
+
+    finishGenerated(validCells);
+}
+
+template<typename _Chunk>
+void ChunkHandle<_Chunk>::generateColumn(IGridDescriptors *descriptors, Generator *generator, size_t lod, ChunkHandle **handles, size_t count)
+{
+    //per thread scratch as in generate, one set of cells per chunk in the batch
+    static thread_local std::vector<typename ChunkType::Cells> scratchCells;
+    std::vector<GenerateChunkRequest> chunks(count);
+    glm::ivec3 chunkSize(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value);
+    size_t cellCount=(ChunkType::sizeX::value*ChunkType::sizeY::value*ChunkType::sizeZ::value)/(lod+1);
+
+    if(scratchCells.size()<count)
+        scratchCells.resize(count);
+
+    for(size_t i=0; i<count; ++i)
+    {
+        glm::vec3 startPos=handles[i]->createGenerated(descriptors, lod);
+
+        scratchCells[i].resize(cellCount);
+        chunks[i]=GenerateChunkRequest(startPos, scratchCells[i].data(), scratchCells[i].size()*sizeof(typename ChunkType::CellType));
+    }
+
+    generator->generateChunks(chunkSize, lod, chunks.data(), count);
+
+    for(size_t i=0; i<count; ++i)
+    {
+        ChunkHandle *handle=handles[i];
+        GenerateChunkRequest &chunk=chunks[i];
+
+        if(chunk.validCells>0)
+        {
+            if(chunk.uniform)
+                handle->m_chunk->setUniform(scratchCells[i][0]);
+            else
+                handle->m_chunk->getCells().swap(scratchCells[i]);
+        }
+
+        handle->finishGenerated(chunk.validCells);
+    }
+}
+
+template<typename _Chunk>
+glm::vec3 ChunkHandle<_Chunk>::createGenerated(IGridDescriptors *descriptors, size_t lod)
 {
     glm::ivec3 chunkIndex=descriptors->getChunkIndex(m_hash);
     glm::vec3 startPos=descriptors->getRegionOffset(m_regionHash);
@@ -23,15 +104,13 @@ void ChunkHandle<_Chunk>::generate(IGridDescriptors *descriptors, Generator *gen
     allocated++;
     Log::debug("ChunkHandle::generate %llx hash:(%d, %d) allocating by generate", this, m_regionHash, m_hash);
 #endif
-    m_chunk=std::make_unique<ChunkType>(m_hash, 0, chunkIndex, chunkOffset, lod);
-
-    if(!m_chunk)
-        return;
-
-    typename ChunkType::Cells &cells=m_chunk->getCells();
-
-    unsigned int validCells=generator->generateChunk(startPos, glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value), cells.data(), cells.size()*sizeof(typename ChunkType::CellType), lod);
+    m_chunk=std::make_unique<ChunkType>(m_hash, 0, chunkIndex, chunkOffset, lod, false);
+    return startPos;
+}
 
+template<typename _Chunk>
+void ChunkHandle<_Chunk>::finishGenerated(unsigned int validCells)
+{
     m_chunk->setValidCellCount(validCells);
 //    setState(HandleState::Memory);
 
@@ -47,7 +126,8 @@ void ChunkHandle<_Chunk>::generate(IGridDescriptors *descriptors, Generator *gen
     }
     else
     {
-        m_memoryUsed=cells.size()*sizeof(typename ChunkType::CellType);
+        m_chunk->pack();
+        m_memoryUsed=m_chunk->memoryUsed();
         setEmpty(false);
     }
 }
@@ -69,42 +149,153 @@ void ChunkHandle<_Chunk>::release()
 }
 
 template<typename _Chunk>
-void ChunkHandle<_Chunk>::read(IGridDescriptors *descriptors, const std::string &fileName, size_t lod)
+bool ChunkHandle<_Chunk>::read(IGridDescriptors *descriptors, RegionPack *pack, size_t lod)
 {
+    if(!pack)
+        return false;
+
     glm::ivec3 chunkIndex=descriptors->getChunkIndex(m_hash);
     glm::vec3 offset=glm::vec3(glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)*chunkIndex);
 
 #ifdef DEBUG_ALLOCATION
     allocated++;
-    Log::debug("ChunkHandle::read %llx hash:(%d, %d) allocating by read", this, m_regionHash, m_hash);
+    Log::debug("ChunkHandle::read %llx hash:(%d, %d) allocating by pack read", this, m_regionHash, m_hash);
 #endif
-    m_chunk=std::make_unique<ChunkType>(m_hash, 0, chunkIndex, offset, lod);
+    size_t size=pack->size(m_hash);
+    uint32_t encoding=pack->flags(m_hash)&RegionPackFlags::EncodingMask;
+    unsigned int revision=pack->revision(m_hash);
+    bool value;
+
+    if(encoding==CellEncoding::Dense)
+    {
+        m_chunk=std::make_unique<ChunkType>(m_hash, revision, chunkIndex, offset, lod);
+
+        auto &cells=m_chunk->getCells();
+
+        value=(size==cells.size()*sizeof(typename ChunkType::CellType));
+        if(value)
+            value=pack->read(m_hash, (char *)cells.data(), size);
+        if(value)
+            m_chunk->pack();
+    }
+    else
+    {
+        std::vector<char> buffer(size);
+
+        m_chunk=std::make_unique<ChunkType>(m_hash, revision, chunkIndex, offset, lod, false);
+
+        value=pack->read(m_hash, buffer.data(), size);
+        if(value)
+            value=m_chunk->setData(buffer.data(), size, encoding);
+    }
+
+    if(!value)
+    {
 #ifdef DEBUG_ALLOCATION
-    Log::debug("ChunkHandle::read %llx hash:(%d, %d) allocated chunk: %llx", this, m_regionHash, m_hash, m_chunk.get());
+        allocated--;
+        Log::debug("ChunkHandle::read %llx hash:(%d, %d) pack read failed", this, m_regionHash, m_hash);
 #endif
+        m_chunk.reset(nullptr);
+        m_memoryUsed=0;
+        return false;
+    }
+
+    m_memoryUsed=m_chunk->memoryUsed();
+    return true;
+}
+
+template<typename _Chunk>
+bool ChunkHandle<_Chunk>::readData(IGridDescriptors *descriptors, const char *data, size_t size, uint32_t encoding, unsigned int revision, size_t lod)
+{
+    glm::ivec3 chunkIndex=descriptors->getChunkIndex(m_hash);
+    glm::vec3 offset=glm::vec3(glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)*chunkIndex);
 
-    auto &cells=m_chunk->getCells();
-    std::ifstream file;
+#ifdef DEBUG_ALLOCATION
+    allocated++;
+    Log::debug("ChunkHandle::readData %llx hash:(%d, %d) allocating by async read", this, m_regionHash, m_hash);
+#endif
+    m_chunk=std::make_unique<ChunkType>(m_hash, revision, chunkIndex, offset, lod, false);
 
-    file.open(fileName, std::ofstream::in|std::ofstream::binary);
-    file.read((char *)cells.data(), cells.size()*sizeof(typename ChunkType::CellType));
-    file.close();
+    if(!m_chunk->setData(data, size, encoding))
+    {
+#ifdef DEBUG_ALLOCATION
+        allocated--;
+        Log::debug("ChunkHandle::readData %llx hash:(%d, %d) bad payload", this, m_regionHash, m_hash);
+#endif
+        m_chunk.reset(nullptr);
+        m_memoryUsed=0;
+        return false;
+    }
 
-    m_memoryUsed=cells.size()*sizeof(typename ChunkType::CellType);
-//    setState(HandleState::Memory);
+    m_chunk->pack();
+    m_memoryUsed=m_chunk->memoryUsed();
+    return true;
+}
+
+template<typename _Chunk>
+bool ChunkHandle<_Chunk>::readMapped(IGridDescriptors *descriptors, RegionPack *pack, size_t lod)
+{
+    if(!pack)
+        return false;
+
+    glm::ivec3 chunkIndex=descriptors->getChunkIndex(m_hash);
+    glm::vec3 offset=glm::vec3(glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)*chunkIndex);
+
+    size_t size=pack->size(m_hash);
+    uint32_t encoding=pack->flags(m_hash)&RegionPackFlags::EncodingMask;
+    unsigned int revision=pack->revision(m_hash);
+    SharedMappedFile mapping;
+
+    const char *data=pack->view(m_hash, size, mapping);
+
+    if(!data) //not mappable, fall back to copy
+        return read(descriptors, pack, lod);
+
+#ifdef DEBUG_ALLOCATION
+    allocated++;
+    Log::debug("ChunkHandle::readMapped %llx hash:(%d, %d) allocating by mapped read", this, m_regionHash, m_hash);
+#endif
+    m_chunk=std::make_unique<ChunkType>(m_hash, revision, chunkIndex, offset, lod, false);
+    if(!m_chunk->setView(data, size, encoding, mapping))
+    {
+#ifdef DEBUG_ALLOCATION
+        allocated--;
+#endif
+        //storage can not view this encoding, fall back to copy
+        m_chunk.reset(nullptr);
+        return read(descriptors, pack, lod);
+    }
+
+    //cells live in the page cache
+    m_memoryUsed=0;
+    return true;
 }
 
 template<typename _Chunk>
-void ChunkHandle<_Chunk>::write(IGridDescriptors *descriptors, const std::string &fileName, size_t lod)
+bool ChunkHandle<_Chunk>::write(IGridDescriptors *descriptors, RegionPack *pack, size_t lod)
 {
-    auto &cells=m_chunk->getCells();
-    std::ofstream file;
+    if(!pack)
+        return false;
+
+    bool value;
+
+    if(m_empty || !m_chunk)
+        value=pack->write(m_hash, nullptr, 0, RegionPackFlags::Empty);
+    else if(m_chunk->isView())
+        value=true; //still viewing the pack, nothing changed
+    else
+    {
+        size_t size;
+        uint32_t encoding;
+        const char *data=m_chunk->getData(size, encoding);
 
-    file.open(fileName, std::ofstream::out|std::ofstream::trunc|std::ofstream::binary);
-    file.write((char *)cells.data(), cells.size()*sizeof(typename ChunkType::CellType));
-    file.close();
+        //revision is kept so a reloaded chunk does not match meshes cached before its edits
+        value=pack->write(m_hash, data, size, RegionPackFlags::Present|encoding, m_chunk->getRevision());
+    }
 
-    m_cachedOnDisk=true;
+    if(value)
+        m_cachedOnDisk=true;
+    return value;
 }
 
 } //namespace voxigen
@@ -0,0 +1,538 @@
+#ifndef _voxigen_chunkStorage_h_
+#define _voxigen_chunkStorage_h_
+
+#include "voxigen/defines.h"
+
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cassert>
+
+namespace voxigen
+{
+
+//cell encodings, stored in the region pack entry flags (RegionPackFlags::EncodingMask)
+namespace CellEncoding
+{
+const uint32_t Dense=0x0000;
+const uint32_t Palette=0x0100;
+const uint32_t Uniform=0x0200; //single cell for the whole chunk (handled by Chunk)
+}
+
+//read only access to a chunks cells, either the chunks own vector or
+//external memory (memory mapped file)
+template<typename _Cell>
+class CellView
+{
+public:
+    CellView():m_cells(nullptr), m_size(0) {}
+    CellView(const _Cell *cells, size_t size):m_cells(cells), m_size(size) {}
+
+    const _Cell &operator[](size_t index) const { return m_cells[index]; }
+    const _Cell *data() const { return m_cells; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size==0; }
+
+    const _Cell *begin() const { return m_cells; }
+    const _Cell *end() const { return m_cells+m_size; }
+
+private:
+    const _Cell *m_cells;
+    size_t m_size;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//Dense storage, array of cells
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename _Cell>
+class DenseStorage
+{
+public:
+    typedef std::vector<_Cell> Cells;
+    typedef CellView<_Cell> View;
+
+    DenseStorage():m_view(nullptr), m_viewSize(0) {}
+
+    void allocate(size_t count) { dropView(); m_cells.resize(count); }
+    void clear() { dropView(); m_cells.clear(); m_cells.shrink_to_fit(); }
+
+    //mutable access, if viewing external memory the cells are copied first (copy on write)
+    Cells &getCells() { if(m_view) copyView(); return m_cells; }
+    View getView() const { return m_view?View(m_view, m_viewSize):View(m_cells.data(), m_cells.size()); }
+
+    //dense is already as small as it gets
+    void pack() {}
+
+    //use external memory for the cells, owner keeps the memory alive
+    bool setView(const char *data, size_t size, uint32_t encoding, size_t count, std::shared_ptr<void> owner)
+    {
+        if((encoding!=CellEncoding::Dense)||(size!=count*sizeof(_Cell)))
+            return false;
+
+        m_cells.clear();
+        m_cells.shrink_to_fit();
+
+        m_view=(const _Cell *)data;
+        m_viewSize=count;
+        m_viewOwner=owner;
+        return true;
+    }
+    bool isView() const { return m_view!=nullptr; }
+
+    bool load(const char *data, size_t size, uint32_t encoding, size_t count);
+    //data for storage on disk, valid until the next change
+    const char *data(size_t &size, uint32_t &encoding)
+    {
+        View view=getView();
+
+        size=view.size()*sizeof(_Cell);
+        encoding=CellEncoding::Dense;
+        return (const char *)view.data();
+    }
+
+    size_t memoryUsed() const { return m_cells.size()*sizeof(_Cell); }
+
+private:
+    void dropView() { m_view=nullptr; m_viewSize=0; m_viewOwner.reset(); }
+    void copyView()
+    {
+        m_cells.assign(m_view, m_view+m_viewSize);
+        dropView();
+    }
+
+    Cells m_cells;
+    const _Cell *m_view; //external block info, used instead of m_cells when set
+    size_t m_viewSize;
+    std::shared_ptr<void> m_viewOwner;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//Palette storage, unique cells in a palette and bit-packed palette indices. The packed layout is the same
+//in memory and on disk (PaletteHeader, palette, indices) so mapped packs can be viewed directly.
+//Cells are unpacked to a dense array when mutable access is requested, pack() drops the dense array again.
+//Chunk::pack is called after generation/reads, Chunk::clearDirty once edits are meshed and data() packs
+//before writing, so unpacked cells only live while a chunk is being changed.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct PaletteHeader
+{
+    uint32_t count;       //number of cells
+    uint32_t paletteSize;
+    uint32_t bitsLog2;    //index bits is 1<<bitsLog2, 0 bits if palette has 1 entry
+    uint32_t paletteBytes;//palette size in bytes, padded to 8 bytes
+};
+
+namespace details
+{
+
+inline uint32_t paletteBitsLog2(size_t paletteSize)
+{
+    if(paletteSize<=2)
+        return 0;
+    if(paletteSize<=4)
+        return 1;
+    if(paletteSize<=16)
+        return 2;
+    if(paletteSize<=256)
+        return 3;
+    return 4;
+}
+
+inline size_t paletteIndexWords(size_t count, size_t paletteSize, uint32_t bitsLog2)
+{
+    if(paletteSize<=1)
+        return 0;
+    size_t perWord=64>>bitsLog2;
+    return (count+perWord-1)/perWord;
+}
+
+const uint32_t PaletteLookup_Unused=0xffffffff;
+
+//open addressing hash of palette indices keyed by the cell bytes, keeps palette lookups
+//constant time while packing
+template<typename _Cell>
+class PaletteLookup
+{
+public:
+    PaletteLookup():m_slots(64, PaletteLookup_Unused) {}
+
+    //index of cell in palette, cell is appended if new
+    size_t find(std::vector<_Cell> &palette, const _Cell &cell)
+    {
+        size_t mask=m_slots.size()-1;
+        size_t slot=hash(cell)&mask;
+
+        while(m_slots[slot]!=PaletteLookup_Unused)
+        {
+            uint32_t index=m_slots[slot];
+
+            if(memcmp(&palette[index], &cell, sizeof(_Cell))==0)
+                return index;
+            slot=(slot+1)&mask;
+        }
+
+        size_t index=palette.size();
+
+        palette.push_back(cell);
+        m_slots[slot]=(uint32_t)index;
+
+        //keep load under half
+        if(palette.size()*2>m_slots.size())
+            rehash(palette);
+        return index;
+    }
+
+private:
+    static size_t hash(const _Cell &cell)
+    {
+        //FNV-1a over the cell bytes
+        const unsigned char *bytes=(const unsigned char *)&cell;
+        uint64_t value=14695981039346656037ull;
+
+        for(size_t i=0; i<sizeof(_Cell); ++i)
+        {
+            value^=bytes[i];
+            value*=1099511628211ull;
+        }
+        return (size_t)(value^(value>>32));
+    }
+
+    void rehash(const std::vector<_Cell> &palette)
+    {
+        m_slots.assign(m_slots.size()*2, PaletteLookup_Unused);
+
+        size_t mask=m_slots.size()-1;
+
+        for(size_t index=0; index<palette.size(); ++index)
+        {
+            size_t slot=hash(palette[index])&mask;
+
+            while(m_slots[slot]!=PaletteLookup_Unused)
+                slot=(slot+1)&mask;
+            m_slots[slot]=(uint32_t)index;
+        }
+    }
+
+    std::vector<uint32_t> m_slots;
+};
+
+}//namespace details
+
+template<typename _Cell>
+class PaletteCellView
+{
+public:
+    PaletteCellView():m_cells(nullptr), m_palette(nullptr), m_indices(nullptr), m_size(0), m_bitsLog2(0), m_paletteSize(0) {}
+    PaletteCellView(const _Cell *cells, size_t size):m_cells(cells), m_palette(nullptr), m_indices(nullptr), m_size(size), m_bitsLog2(0), m_paletteSize(0) {}
+    PaletteCellView(const char *packed)
+    {
+        const PaletteHeader *header=(const PaletteHeader *)packed;
+
+        m_cells=nullptr;
+        m_size=header->count;
+        m_paletteSize=header->paletteSize;
+        m_bitsLog2=header->bitsLog2;
+        m_palette=(const _Cell *)(packed+sizeof(PaletteHeader));
+        m_indices=(const uint64_t *)(packed+sizeof(PaletteHeader)+header->paletteBytes);
+    }
+
+    _Cell operator[](size_t index) const
+    {
+        if(m_cells)
+            return m_cells[index];
+        return m_palette[paletteIndex(index)];
+    }
+
+    size_t paletteIndex(size_t index) const
+    {
+        if(m_paletteSize<=1)
+            return 0;
+
+        size_t bits=(size_t)1<<m_bitsLog2;
+        size_t wordShift=6-m_bitsLog2;
+        size_t word=index>>wordShift;
+        size_t shift=(index&((1<<wordShift)-1))<<m_bitsLog2;
+
+        return (m_indices[word]>>shift)&((1ull<<bits)-1);
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size==0; }
+
+    //checks packed data before it is viewed, the header sizes have to fit in size and
+    //every index has to be in the palette
+    static bool valid(const char *packed, size_t size, size_t count);
+
+    //single cell type for every cell
+    bool uniform() const { return (m_cells==nullptr)&&(m_paletteSize==1); }
+
+    //dense pointer if unpacked, nullptr otherwise
+    const _Cell *data() const { return m_cells; }
+    const _Cell *palette() const { return m_palette; }
+    size_t paletteSize() const { return m_paletteSize; }
+
+private:
+    const _Cell *m_cells;
+    const _Cell *m_palette;
+    const uint64_t *m_indices;
+    size_t m_size;
+    uint32_t m_bitsLog2;
+    size_t m_paletteSize;
+};
+
+template<typename _Cell>
+bool PaletteCellView<_Cell>::valid(const char *packed, size_t size, size_t count)
+{
+    if(size<sizeof(PaletteHeader))
+        return false;
+
+    PaletteHeader header;
+
+    memcpy(&header, packed, sizeof(PaletteHeader));
+
+    if(header.count!=count)
+        return false;
+    if(header.bitsLog2>4)
+        return false;
+    if((count>0)&&(header.paletteSize==0))
+        return false;
+    if((uint64_t)header.paletteBytes<(uint64_t)header.paletteSize*sizeof(_Cell))
+        return false;
+
+    size_t words=details::paletteIndexWords(count, header.paletteSize, header.bitsLog2);
+
+    if((uint64_t)size<(uint64_t)sizeof(PaletteHeader)+header.paletteBytes+(uint64_t)words*sizeof(uint64_t))
+        return false;
+
+    if(header.paletteSize<=1)
+        return true;
+
+    PaletteCellView<_Cell> view(packed);
+
+    for(size_t i=0; i<count; ++i)
+    {
+        if(view.paletteIndex(i)>=header.paletteSize)
+            return false;
+    }
+    return true;
+}
+
+template<typename _Cell>
+class PaletteStorage
+{
+public:
+    typedef std::vector<_Cell> Cells;
+    typedef PaletteCellView<_Cell> View;
+
+    PaletteStorage():m_packedData(nullptr), m_packedSize(0) {}
+
+    void allocate(size_t count) { dropPacked(); m_cells.resize(count); }
+    void clear() { dropPacked(); m_cells.clear(); m_cells.shrink_to_fit(); }
+
+    //mutable access, unpacks the cells if needed
+    Cells &getCells() { if(m_packedData) unpack(); return m_cells; }
+    View getView() const { return m_packedData?View(m_packedData):View(m_cells.data(), m_cells.size()); }
+
+    //encodes dense cells and frees them
+    void pack();
+
+    bool setView(const char *data, size_t size, uint32_t encoding, size_t count, std::shared_ptr<void> owner)
+    {
+        if(encoding!=CellEncoding::Palette)
+            return false;
+        if(!View::valid(data, size, count))
+            return false;
+
+        m_cells.clear();
+        m_cells.shrink_to_fit();
+        m_packed.clear();
+        m_packed.shrink_to_fit();
+
+        m_packedData=data;
+        m_packedSize=size;
+        m_viewOwner=owner;
+        return true;
+    }
+    bool isView() const { return m_viewOwner!=nullptr; }
+
+    bool load(const char *data, size_t size, uint32_t encoding, size_t count);
+    const char *data(size_t &size, uint32_t &encoding)
+    {
+        if(!m_packedData)
+            pack();
+
+        if(!m_packedData) //palette too large, store dense
+        {
+            size=m_cells.size()*sizeof(_Cell);
+            encoding=CellEncoding::Dense;
+            return (const char *)m_cells.data();
+        }
+
+        size=m_packedSize;
+        encoding=CellEncoding::Palette;
+        return m_packedData;
+    }
+
+    size_t memoryUsed() const { return m_cells.size()*sizeof(_Cell)+m_packed.size(); }
+
+private:
+    void unpack();
+    void dropPacked() { m_packedData=nullptr; m_packedSize=0; m_packed.clear(); m_packed.shrink_to_fit(); m_viewOwner.reset(); }
+
+    Cells m_cells; //dense working copy, empty while packed
+
+    std::vector<char> m_packed;
+    const char *m_packedData; //m_packed or external memory
+    size_t m_packedSize;
+    std::shared_ptr<void> m_viewOwner;
+};
+
+template<typename _Cell>
+bool DenseStorage<_Cell>::load(const char *data, size_t size, uint32_t encoding, size_t count)
+{
+    dropView();
+
+    if(encoding==CellEncoding::Dense)
+    {
+        if(size!=count*sizeof(_Cell))
+            return false;
+
+        m_cells.resize(count);
+        memcpy(m_cells.data(), data, size);
+        return true;
+    }
+    else if(encoding==CellEncoding::Palette)
+    {
+        if(!PaletteCellView<_Cell>::valid(data, size, count))
+            return false;
+
+        PaletteCellView<_Cell> view(data);
+
+        m_cells.resize(count);
+        for(size_t i=0; i<count; ++i)
+            m_cells[i]=view[i];
+        return true;
+    }
+    return false;
+}
+
+template<typename _Cell>
+void PaletteStorage<_Cell>::pack()
+{
+    if(m_packedData)
+        return;
+
+    size_t count=m_cells.size();
+    std::vector<_Cell> palette;
+    std::vector<uint32_t> indices(count);
+    details::PaletteLookup<_Cell> lookup;
+    size_t lastIndex=0;
+
+    //cells are pod, compare as bytes. runs are common so check the last hit first
+    for(size_t i=0; i<count; ++i)
+    {
+        const _Cell &cell=m_cells[i];
+
+        if(!palette.empty()&&(memcmp(&palette[lastIndex], &cell, sizeof(_Cell))==0))
+        {
+            indices[i]=(uint32_t)lastIndex;
+            continue;
+        }
+
+        size_t index=lookup.find(palette, cell);
+
+        //more than 16 bits of palette, not worth packing
+        if(palette.size()>65536)
+            return;
+
+        indices[i]=(uint32_t)index;
+        lastIndex=index;
+    }
+
+    PaletteHeader header;
+
+    header.count=(uint32_t)count;
+    header.paletteSize=(uint32_t)palette.size();
+    header.bitsLog2=details::paletteBitsLog2(palette.size());
+    header.paletteBytes=(uint32_t)((palette.size()*sizeof(_Cell)+7)&~(size_t)7);
+
+    size_t words=details::paletteIndexWords(count, palette.size(), header.bitsLog2);
+
+    m_packed.assign(sizeof(PaletteHeader)+header.paletteBytes+words*sizeof(uint64_t), 0);
+
+    memcpy(m_packed.data(), &header, sizeof(PaletteHeader));
+    if(!palette.empty())
+        memcpy(m_packed.data()+sizeof(PaletteHeader), palette.data(), palette.size()*sizeof(_Cell));
+
+    if(words>0)
+    {
+        uint64_t *packedIndices=(uint64_t *)(m_packed.data()+sizeof(PaletteHeader)+header.paletteBytes);
+        size_t bits=(size_t)1<<header.bitsLog2;
+        size_t wordShift=6-header.bitsLog2;
+
+        for(size_t i=0; i<count; ++i)
+        {
+            size_t word=i>>wordShift;
+            size_t shift=(i&((1<<wordShift)-1))<<header.bitsLog2;
+
+            packedIndices[word]|=((uint64_t)indices[i])<<shift;
+        }
+    }
+
+    m_packedData=m_packed.data();
+    m_packedSize=m_packed.size();
+
+    m_cells.clear();
+    m_cells.shrink_to_fit();
+}
+
+template<typename _Cell>
+void PaletteStorage<_Cell>::unpack()
+{
+    View view(m_packedData);
+    size_t count=view.size();
+
+    m_cells.resize(count);
+
+    if(view.uniform())
+        std::fill(m_cells.begin(), m_cells.end(), view.palette()[0]);
+    else
+    {
+        for(size_t i=0; i<count; ++i)
+            m_cells[i]=view[i];
+    }
+
+    dropPacked();
+}
+
+template<typename _Cell>
+bool PaletteStorage<_Cell>::load(const char *data, size_t size, uint32_t encoding, size_t count)
+{
+    dropPacked();
+
+    if(encoding==CellEncoding::Palette)
+    {
+        if(!View::valid(data, size, count))
+            return false;
+
+        m_cells.clear();
+        m_packed.assign(data, data+size);
+        m_packedData=m_packed.data();
+        m_packedSize=m_packed.size();
+        return true;
+    }
+    else if(encoding==CellEncoding::Dense)
+    {
+        if(size!=count*sizeof(_Cell))
+            return false;
+
+        m_cells.resize(count);
+        memcpy(m_cells.data(), data, size);
+        pack();
+        return true;
+    }
+    return false;
+}
+
+} //namespace voxigen
+
+#endif //_voxigen_chunkStorage_h_
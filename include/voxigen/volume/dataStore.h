@@ -7,6 +7,7 @@
 #include "voxigen/generators/generator.h"
 #include "voxigen/fileio/jsonSerializer.h"
 #include "voxigen/fileio/simpleFilesystem.h"
+#include "voxigen/asyncIo.h"
 //#include "voxigen/processQueue.h"
 #include "voxigen/fileio/log.h"
 
@@ -132,6 +133,15 @@ public:
     void readChunk(ChunkHandleType *handle);
     void writeChunk(ChunkHandleType *handle);
 
+    //async read of a chunk, prepare fills in where the chunk is in its region pack
+    //complete builds the chunk from the read data
+    bool prepareReadChunk(ChunkHandleType *handle, IoOperation &operation);
+    bool completeReadChunk(ChunkHandleType *handle, IoOperation &operation);
+
+    //chunks read from the region pack view the memory mapped file instead of copying
+    void setMappedRead(bool mapped) { m_mappedRead=mapped; }
+    bool mappedRead() { return m_mappedRead; }
+
 protected:
     virtual DataHandle *newHandle(HashType hash);
 
@@ -156,6 +166,7 @@ private:
     std::string m_configFile;
     std::string m_cacheDirectory;
     unsigned int m_version;
+    bool m_mappedRead;
 
 //IO thread
 //    std::thread m_ioThread;
@@ -4,7 +4,8 @@ namespace voxigen
 
 template<typename _Grid>
 DataStore<_Grid>::DataStore(GridDescriptors<_Grid> *descriptors):
-m_descriptors(descriptors)
+m_descriptors(descriptors),
+m_mappedRead(false)
 {
     m_version=0;
 }
@@ -34,7 +35,13 @@ template<typename _Grid>
 typename DataStore<_Grid>::DataHandle *DataStore<_Grid>::newHandle(HashType hash)
 {
 //    return new RegionHandleType(hash, m_descriptors, m_generatorQueue, this, m_updateQueue);
-    return new RegionHandleType(hash, m_descriptors);
+    RegionHandleType *handle=new RegionHandleType(hash, m_descriptors);
+    std::ostringstream directoryName;
+
+    directoryName<<std::hex<<hash;
+    handle->setDirectory(m_directory+"/"+directoryName.str());
+
+    return handle;
 }
 
 template<typename _Grid>
@@ -251,7 +258,19 @@ void DataStore<_Grid>::loadDataStore()
 template<typename _Grid>
 void DataStore<_Grid>::verifyDirectory()
 {
+    //older versions wrote chunk_<hash>.chk files named only by chunk hash (shared by
+    //every region) and never read them back, they can not be moved into the region packs
+    std::vector<std::string> files=fs::get_files(m_directory);
+    size_t legacyFiles=0;
+
+    for(const std::string &file:files)
+    {
+        if((file.size()>10)&&(file.compare(0, 6, "chunk_")==0)&&(file.compare(file.size()-4, 4, ".chk")==0))
+            legacyFiles++;
+    }
 
+    if(legacyFiles>0)
+        Log::warning("DataStore %s has %d chunk files from an older version, they are ignored and the chunks regenerated into region packs", m_directory.c_str(), (int)legacyFiles);
 }
 
 template<typename _Grid>
@@ -456,25 +475,23 @@ void DataStore<_Grid>::readChunk(ChunkHandleType *chunkHandle)
 
     if(!chunkHandle->empty())
     {
-        std::ostringstream fileNameStream;
+        //chunk lives in its region's pack, only its payload is read unless mapped,
+        //then the chunk just views the file
+        bool value;
 
-        fileNameStream<<"/chunk_"<<std::right<<std::setfill('0')<<std::setw(8)<<std::hex<<chunkHandle->hash()<<".chk";
-        std::string fileName=m_directory+fileNameStream.str();
+        if(m_mappedRead)
+            value=chunkHandle->readMapped(m_descriptors, chunkHandle->regionPack());
+        else
+            value=chunkHandle->read(m_descriptors, chunkHandle->regionPack());
 
-        chunkHandle->read(m_descriptors, fileName);
-//        glm::ivec3 chunkIndex=m_descriptors->chunkIndex(chunkHandle->hash);
-//        glm::vec3 offset=glm::ivec3(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value)*chunkIndex;
-//
-//        chunkHandle->chunk=std::make_unique<ChunkType>(chunkHandle->hash, 0, chunkIndex, offset);
-//
-//        auto &cells=chunkHandle->chunk->getCells();
-//        std::ifstream file;
-//
-//        file.open(fileName, std::ofstream::in|std::ofstream::binary);
-//        //        for(auto block:blocks)
-//        //            block->deserialize(file);
-//        file.read((char *)cells.data(), cells.size()*sizeof(_Grid::CellType));
-//        file.close();
+        if(!value)
+        {
+#ifdef LOG_PROCESS_QUEUE
+            Log::debug("IOThread - ChunkHandle %llx (%d, %d) pack read failed\n", chunkHandle, chunkHandle->regionHash(), chunkHandle->hash());
+#endif//LOG_PROCESS_QUEUE
+            //pack does not have it (or is damaged), allow it to be generated again
+            chunkHandle->setCachedOnDisk(false);
+        }
     }
 
 //    chunkHandle->status=ChunkHandleType::Memory;
@@ -482,6 +499,54 @@ void DataStore<_Grid>::readChunk(ChunkHandleType *chunkHandle)
 //    m_updateQueue->add(chunkHandle->hash());
 }
 
+template<typename _Grid>
+bool DataStore<_Grid>::prepareReadChunk(ChunkHandleType *chunkHandle, IoOperation &operation)
+{
+    //mapped reads are already zero-copy
+    if(!chunkHandle || chunkHandle->empty() || m_mappedRead)
+        return false;
+
+    RegionPack *pack=chunkHandle->regionPack();
+
+    if(!pack)
+        return false;
+
+    size_t size;
+
+    if(!pack->locate(chunkHandle->hash(), operation.file, operation.offset, size, operation.flags))
+        return false;
+
+    operation.buffer.resize(size);
+    return true;
+}
+
+template<typename _Grid>
+bool DataStore<_Grid>::completeReadChunk(ChunkHandleType *chunkHandle, IoOperation &operation)
+{
+    bool value=false;
+    RegionPack *pack=chunkHandle->regionPack();
+    unsigned int revision=0;
+
+    //read is done with the pack's file
+    if(pack)
+    {
+        revision=pack->revision(chunkHandle->hash());
+        pack->endRead();
+    }
+
+    if(operation.result==(int64_t)operation.buffer.size())
+        value=chunkHandle->readData(m_descriptors, operation.buffer.data(), operation.buffer.size(), operation.flags&RegionPackFlags::EncodingMask, revision);
+
+    if(!value)
+    {
+#ifdef LOG_PROCESS_QUEUE
+        Log::debug("IOThread - ChunkHandle %llx (%d, %d) async read failed %d\n", chunkHandle, chunkHandle->regionHash(), chunkHandle->hash(), (int)operation.result);
+#endif//LOG_PROCESS_QUEUE
+        chunkHandle->setCachedOnDisk(false);
+    }
+    return value;
+}
+
 template<typename _Grid>
 void DataStore<_Grid>::writeChunk(IORequestType *request)
 {
@@ -499,29 +564,14 @@ void DataStore<_Grid>::writeChunk(ChunkHandleType *chunkHandle)
 //    IOWriteRequestType *writeRequest=(IOWriteRequestType *)request;
 //    SharedChunkHandle chunkHandle=writeRequest->chunkHandle;
 
-    if(!chunkHandle->empty())
+    //empty chunks are recorded in the pack table as well so no config update is needed
+    if(!chunkHandle->write(m_descriptors, chunkHandle->regionPack()))
     {
-        std::ostringstream fileNameStream;
-
-        fileNameStream<<"/chunk_"<<std::right<<std::setfill('0')<<std::setw(8)<<std::hex<<chunkHandle->hash()<<".chk";
-        std::string fileName=m_directory+fileNameStream.str();
-
-        chunkHandle->write(m_descriptors, fileName);
-//        auto &cells=chunkHandle->chunk->getCells();
-//        std::ofstream file;
-//
-//        file.open(fileName, std::ofstream::out|std::ofstream::trunc|std::ofstream::binary);
-//        //        for(auto block:blocks)
-//        //            block->serialize(file);
-//        file.write((char *)cells.data(), cells.size()*sizeof(_Grid::CellType));
-//        file.close();
+        Log::error("IOThread - ChunkHandle (%d, %d) region pack write failed, chunk will be regenerated", chunkHandle->regionHash(), chunkHandle->hash());
+        //nothing valid on disk for it
+        chunkHandle->setCachedOnDisk(false);
     }
 
-//    chunkHandle->cachedOnDisk=true;
-    
-    //need to alter this to save in batched and update config then
-    addConfig(chunkHandle);
-
     //drop shared_ptr
 //    writeRequest->chunkHandle.reset();
 }
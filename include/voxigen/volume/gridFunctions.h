@@ -41,7 +41,7 @@ template<typename _Region>
 constexpr glm::ivec3 regionSize() { return glm::ivec3(_Region::sizeX::value, _Region::sizeY::value, _Region::sizeZ::value); }
 
 template<typename _Grid>
-constexpr glm::ivec3 regionCount() { return glm::ivec3(_Region::sizeX::value, _Region::sizeY::value, _Region::sizeZ::value); }
+constexpr glm::ivec3 regionCount() { return regionSize<typename _Grid::RegionType>(); }
 
 template<typename _Region, typename _Chunk>
 constexpr glm::ivec3 regionCellSize() { return regionSize<_Region>()*chunkSize<_Chunk>(); }
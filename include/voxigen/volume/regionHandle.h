@@ -4,6 +4,7 @@
 #include "voxigen/volume/chunkHandle.h"
 #include "voxigen/volume/dataHandler.h"
 #include "voxigen/volume/dataStore.h"
+#include "voxigen/volume/regionPack.h"
 #include "voxigen/volume/gridDescriptors.h"
 #include "voxigen/generators/generator.h"
 #include "voxigen/fileio/simpleFilesystem.h"
@@ -81,6 +82,11 @@ public:
 
     bool load(const std::string &name);
 
+    //sets region directory, chunks are stored in a single pack file in it
+    void setDirectory(const std::string &directory);
+    const std::string &getDirectory() { return m_directory; }
+    RegionPack &getPack() { return m_pack; }
+
     void addConfig(ChunkHandleType *handle);
 
     RegionHash hash() { return m_hash; }
@@ -128,6 +134,9 @@ private:
     std::string m_directory;
     std::string m_configFile;
 
+    RegionPack m_pack;
+    bool m_packChecked;
+
     Cells m_heightMap;
     size_t m_heightMapLod;
 
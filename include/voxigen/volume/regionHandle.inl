@@ -13,7 +13,8 @@ m_descriptors(descriptors),
 //m_dataStore(dataStore),
 //m_updateQueue(updateQueue),
 m_cachedOnDisk(false),
-m_empty(false)
+m_empty(false),
+m_packChecked(false)
 {
     m_index=descriptors->getRegionIndex(regionHash);
 }
@@ -59,13 +60,24 @@ void RegionHandle<_Region>::release()
 #endif
     }
     m_heightMap.clear();
+    m_pack.release();
 //    m_memoryUsed=0;
 }
 
 template<typename _Region>
-bool RegionHandle<_Region>::load(const std::string &directory)
+void RegionHandle<_Region>::setDirectory(const std::string &directory)
 {
     m_directory=directory;
+    m_configFile=m_directory+"/regionConfig.json";
+
+    m_pack.setFile(m_directory+"/region.pak", RegionType::sizeX::value*RegionType::sizeY::value*RegionType::sizeZ::value);
+    m_packChecked=false;
+}
+
+template<typename _Region>
+bool RegionHandle<_Region>::load(const std::string &directory)
+{
+    setDirectory(directory);
 
     if(!fs::is_directory(directory))
     {
@@ -75,8 +87,6 @@ bool RegionHandle<_Region>::load(const std::string &directory)
         fs::create_directory(directory);
     }
 
-    m_configFile=m_directory+"/regionConfig.json";
-
     if(!fs::exists(m_configFile))
         saveConfig();
     else
@@ -97,7 +107,24 @@ typename RegionHandle<_Region>::DataHandle *RegionHandle<_Region>::newHandle(Has
     glm::ivec3 regionIndex=m_descriptors->getRegionIndex(m_hash);
     glm::ivec3 chunkIndex=m_descriptors->getChunkIndex(chunkHash);
 
-    return new ChunkHandleType(m_hash, regionIndex, chunkHash, chunkIndex);
+    ChunkHandleType *handle=new ChunkHandleType(m_hash, regionIndex, chunkHash, chunkIndex);
+
+    handle->setRegionPack(&m_pack);
+
+    //only reads the offset table, payloads are loaded on the first chunk read
+    if(!m_packChecked)
+    {
+        m_pack.open();
+        m_packChecked=true;
+    }
+
+    if(m_pack.contains(chunkHash))
+    {
+        handle->setCachedOnDisk(true);
+        handle->setEmpty((m_pack.flags(chunkHash)&RegionPackFlags::Empty)!=0);
+    }
+
+    return handle;
 }
 
 template<typename _Region>
@@ -194,23 +221,21 @@ void RegionHandle<_Region>::addConfig(ChunkHandleType *handle)
 template<typename _Region>
 void RegionHandle<_Region>::loadDataStore()
 {
-    std::vector<std::string> directories=fs::get_directories(m_directory);
-
-    for(auto &entry:directories)
-    {
-        std::istringstream fileNameStream(entry);
-        ChunkHash chunkHash;
+    //chunks on disk are listed in the pack offset table
+    m_pack.open();
+    m_packChecked=true;
 
-        fileNameStream.ignore(6);
-        fileNameStream>>std::hex>>chunkHash;
+    ChunkHash chunkCount=RegionType::sizeX::value*RegionType::sizeY::value*RegionType::sizeZ::value;
 
-        glm::ivec3 regionIndex=m_descriptors->getRegionIndex(m_hash);
-        glm::ivec3 chunkIndex=m_descriptors->getChunkIndex(chunkHash);
+    for(ChunkHash chunkHash=0; chunkHash<chunkCount; ++chunkHash)
+    {
+        if(!m_pack.contains(chunkHash))
+            continue;
 
-        SharedChunkHandle handle=std::make_shared<ChunkHandleType>(m_hash, regionIndex, chunkHash, chunkIndex);
+        if(this->m_dataHandles.find(chunkHash)!=this->m_dataHandles.end())
+            continue;
 
-        handle->setCachedOnDisk(true);
-        handle->setEmpty(false);
+        SharedChunkHandle handle(newHandle(chunkHash));
 
         this->m_dataHandles.insert(typename SharedDataHandleMap::value_type(chunkHash, handle));
     }
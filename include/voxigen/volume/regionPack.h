@@ -0,0 +1,120 @@
+#ifndef _voxigen_regionPack_h_
+#define _voxigen_regionPack_h_
+
+#include "voxigen/voxigen_export.h"
+#include "voxigen/defines.h"
+#include "voxigen/fileio/mappedFile.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+
+namespace voxigen
+{
+
+//Region pack file layout
+//  RegionPackHeader
+//  RegionPackEntry[chunkCount] - indexed by chunk hash (chunk hash is the index inside the region)
+//  chunk payloads, each aligned to RegionPack_Alignment
+constexpr unsigned int RegionPackHeader_Marker=0x6b617072; //"rpak"
+constexpr unsigned int RegionPackHeader_Version=1;
+constexpr size_t RegionPack_Alignment=16;
+//packs with more unused bytes than this (and more than half the payload space) are compacted on open
+constexpr uint64_t RegionPack_CompactMinimum=1024*1024;
+
+namespace RegionPackFlags
+{
+const uint32_t Present=0x01;
+const uint32_t Empty=0x02;
+const uint32_t EncodingMask=0xff00; //cell encoding of the payload (CellEncoding)
+}
+
+struct RegionPackHeader
+{
+    unsigned int marker;
+    unsigned int version;
+    unsigned int chunkCount;
+    unsigned int reserved;
+};
+
+struct RegionPackEntry
+{
+    uint64_t offset;  //0 if no payload
+    uint32_t size;    //bytes used
+    uint32_t capacity;//bytes reserved in file, allows re-write in place
+    uint32_t flags;   //RegionPackFlags
+    uint32_t revision;//chunk revision the payload was written at
+};
+
+//Single file holding all the chunks of a region, the offset table is read on
+//open and each payload is read from its own offset as the chunk is needed.
+//read/write will open the file if needed, write creates it. A damaged pack is
+//moved to .bad on write and a new one started. Slots left behind by re-writes
+//that grew are reclaimed by compacting the pack when it is opened.
+class VOXIGEN_EXPORT RegionPack
+{
+public:
+    RegionPack();
+    ~RegionPack();
+
+    void setFile(const std::string &fileName, size_t chunkCount);
+    const std::string &getFile() { return m_fileName; }
+
+    //opens existing pack, create will make the file (and directory) if missing
+    bool open(bool create=false);
+    void close();
+    bool isOpen();
+
+    bool contains(ChunkHash hash);
+    size_t size(ChunkHash hash);
+    uint32_t flags(ChunkHash hash);
+    uint32_t revision(ChunkHash hash);
+
+    bool read(ChunkHash hash, char *buffer, size_t size);
+    //zero-copy read, returns pointer into the memory mapped pack, the mapping 
+    //is kept alive as long as the returned SharedMappedFile is held
+    const char *view(ChunkHash hash, size_t size, SharedMappedFile &mapping);
+    bool write(ChunkHash hash, const char *buffer, size_t size, uint32_t flags=RegionPackFlags::Present, uint32_t revision=0);
+
+    //location of a chunk payload for async reads, fails if the platform has no
+    //native handle. Every successful locate needs an endRead once the read is done,
+    //close waits for them
+    bool locate(ChunkHash hash, int &file, uint64_t &offset, size_t &size, uint32_t &flags);
+    void endRead();
+
+    //drops the mapping, table is kept
+    void release();
+
+private:
+    bool openFile(bool create);
+    bool createFile();
+    bool readTable();
+    bool compact();
+    bool readPayload(const RegionPackEntry &entry, char *buffer);
+    int nativeFile();
+
+    std::mutex m_mutex;
+
+    std::string m_fileName;
+    std::fstream m_file;
+    bool m_open;
+    int m_nativeFile; //read only descriptor used for positional async reads
+    size_t m_pendingReads; //async reads using m_nativeFile
+    std::condition_variable m_readEvent;
+
+    RegionPackHeader m_header;
+    std::vector<RegionPackEntry> m_entries;
+
+    uint64_t m_dataOffset;
+    uint64_t m_fileEnd;
+    uint64_t m_unused; //bytes in the payload area no entry uses
+
+    //current mapping of the file, remapped if the file grows past it
+    SharedMappedFile m_mapping;
+};
+
+} //namespace voxigen
+
+#endif //_voxigen_regionPack_h_
@@ -40,15 +40,15 @@ using UniqueChunkMap=std::unordered_map<ChunkHash, UniqueChunk<_Cell, _ChunkSize
 //    typedef std::shared_ptr<ChunkHandleType> SharedChunkHandle;
 //};
 
-template<typename _Cell, size_t _ChunkSizeX=64, size_t _ChunkSizeY=64, size_t _ChunkSizeZ=64, size_t _RegionSizeX=16, size_t _RegionSizeY=16, size_t _RegionSizeZ=16, bool _Thread=true>
+template<typename _Cell, size_t _ChunkSizeX=64, size_t _ChunkSizeY=64, size_t _ChunkSizeZ=64, size_t _RegionSizeX=16, size_t _RegionSizeY=16, size_t _RegionSizeZ=16, bool _Thread=true, typename _Storage=DenseStorage<_Cell>>
 class RegularGrid
 {
 public:
     RegularGrid();
     ~RegularGrid();
 
-    typedef RegularGrid< _Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ, _RegionSizeX, _RegionSizeY, _RegionSizeZ> Type;
-    typedef RegularGrid< _Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ, _RegionSizeX, _RegionSizeY, _RegionSizeZ> GridType;
+    typedef RegularGrid< _Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ, _RegionSizeX, _RegionSizeY, _RegionSizeZ, _Thread, _Storage> Type;
+    typedef RegularGrid< _Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ, _RegionSizeX, _RegionSizeY, _RegionSizeZ, _Thread, _Storage> GridType;
     typedef std::integral_constant<size_t, _ChunkSizeX*_RegionSizeX> regionCellSizeX;
     typedef std::integral_constant<size_t, _ChunkSizeY*_RegionSizeY> regionCellSizeY;
     typedef std::integral_constant<size_t, _ChunkSizeZ*_RegionSizeZ> regionCellSizeZ;
@@ -56,9 +56,10 @@ public:
     typedef GridDescriptors<GridType> DescriptorType;
     typedef GridDescriptors<GridType> Descriptor;
     typedef _Cell CellType;
+    typedef _Storage StorageType;
 
-    typedef Chunk<_Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ> ChunkType;
-    typedef Chunk<_Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ> Chunk;
+    typedef Chunk<_Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ, _Storage> ChunkType;
+    typedef Chunk<_Cell, _ChunkSizeX, _ChunkSizeY, _ChunkSizeZ, _Storage> Chunk;
     typedef ChunkHandle<ChunkType> ChunkHandleType;
     typedef std::shared_ptr<ChunkHandleType> SharedChunkHandle;
 
@@ -138,6 +139,9 @@ public:
     size_t getChunkRequestSize();
     void setChunkRequestSize(size_t size);
 
+    //read chunks as views of the memory mapped region packs, copied on edit
+    void setMappedRead(bool mapped) { m_dataStore.setMappedRead(mapped); }
+
     glm::vec3 gridPosToRegionPos(RegionHash regionHash, const glm::vec3 &gridPosition);
 
     DescriptorType &getDescriptors() { return m_descriptors; }
@@ -156,6 +160,9 @@ public:
     bool processUpdate(process::Request *request);
     bool processRelease(process::Request *request);
 
+    bool prepareIoRequest(process::Request *request, IoOperation &operation);
+    bool completeIoRequest(process::Request *request, IoOperation &operation);
+
     bool alignPosition(glm::ivec3 &regionIndex, glm::vec3 &position);
 
 private:
@@ -0,0 +1,115 @@
+#ifndef _voxigen_workStealingExecutor_h_
+#define _voxigen_workStealingExecutor_h_
+
+#include "voxigen/voxigen_export.h"
+#include "voxigen/processRequests.h"
+
+#include <memory>
+#include <thread>
+#include <deque>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+
+namespace voxigen
+{
+
+//Worker pool with a set of priority buckets per worker in place of a single heap.
+//Requests are bucketed by priority then chebyshev ring (in chunks) from the current
+//position, workers take from the front of their best bucket and steal from the back
+//of other workers when they run dry. Ordering is approximate (fifo inside a bucket)
+//so there is no global sort and no lock shared by all the workers.
+//
+//Position updates do not touch the queued requests, each entry remembers the
+//position version it was bucketed with. Every pop re-keys a few entries (moving them
+//either way) until the worker's buckets are swept, stale entries found at the front
+//while popping are re-keyed on the spot.
+class VOXIGEN_EXPORT WorkStealingExecutor
+{
+public:
+    typedef std::vector<process::Request *> RequestQueue;
+
+    WorkStealingExecutor(std::condition_variable *completeEvent);
+    ~WorkStealingExecutor();
+
+    void setCallback(process::Callback callback);
+
+    void start(size_t threadCount=1);
+    void stop();
+
+    //only called from the coordination thread
+    void updateQueue(RequestQueue &queue, RequestQueue &cancelQueue, RequestQueue &completedQueue, bool forceResort);
+
+    bool defaultCallback(process::Request *request) { return true; }
+
+private:
+    static const size_t PriorityLevels=4;
+    static const size_t DistanceLevels=32;
+    static const size_t BucketCount=PriorityLevels*DistanceLevels;
+    //max entries re-keyed by a single pop, spreads re-keying across pops
+    static const size_t RekeyLimit=64;
+    //failed pop/steal attempts with requests pending before yielding, then parking
+    static const size_t IdleSpins=32;
+    static const size_t IdleYields=16;
+    static const size_t IdleWait=500; //us
+
+
+    struct Entry
+    {
+        process::Request *request;
+        size_t version;
+    };
+    typedef std::array<std::deque<Entry>, BucketCount> Buckets;
+
+    struct Worker
+    {
+        std::mutex mutex;
+        Buckets buckets;
+        size_t count;
+
+        //position the buckets are keyed against
+        size_t version;
+        glm::ivec3 region;
+        glm::ivec3 chunk;
+        //re-key sweep position, rekeyBucket==BucketCount once swept
+        size_t rekeyBucket;
+        size_t rekeyEntry;
+
+        RequestQueue completed;
+    };
+
+    //thread function
+    void process(size_t index);
+
+    static size_t getBucket(const process::Request *request, const glm::ivec3 &region, const glm::ivec3 &chunk);
+
+    static void rekey(Worker &worker);
+    process::Request *popRequest(size_t index);
+    process::Request *stealRequest(size_t index);
+
+    //cancels are separate requests naming the chunk handle of the request they cancel
+    static bool cancels(const process::Request *cancel, const process::Request *request);
+    static bool canceled(const process::Request *request, const RequestQueue &cancelQueue);
+    //completes queued requests (and members of their generate batches) as canceled
+    void removeRequests(Worker &worker, RequestQueue &cancelQueue, RequestQueue &completed);
+
+    process::Callback processRequest;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    size_t m_nextWorker;
+
+    //only used to sleep/wake idle workers
+    std::mutex m_mutex;
+    std::condition_variable m_event;
+    std::condition_variable *m_completeEvent;
+
+    std::atomic<bool> m_run;
+    std::atomic<size_t> m_pending;
+};
+
+}//namespace voxigen
+
+#endif //_voxigen_workStealingExecutor_h_
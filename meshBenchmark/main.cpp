@@ -0,0 +1,417 @@
+#include "voxigen/defines.h"
+#include "voxigen/volume/cell.h"
+#include "voxigen/volume/regularGrid.h"
+#include "voxigen/generators/equiRectWorldGenerator.h"
+#include "voxigen/meshbuilders/meshBuilder.h"
+#include "voxigen/meshes/chunkTextureMesh.h"
+#include "voxigen/texturing/textureAtlas.h"
+
+#include <gflags/gflags.h>
+
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+
+DEFINE_int32(iterations, 20, "Number of times each corpus is meshed");
+DEFINE_string(lods, "0,1,2", "Comma separated list of lods to mesh");
+DEFINE_string(meshers, "all", "Comma separated list of meshers (cubic, greedy, bitmask, layered, padded, paddedGreedy)");
+DEFINE_bool(world, true, "Include chunks from EquiRectWorldGenerator in the corpus");
+DEFINE_int32(world_seed, 0, "Seed of the generated world");
+DEFINE_int32(world_columns, 4, "Chunk columns (per side) taken from the generated world");
+DEFINE_int32(world_layers, 4, "Chunks per column taken from the generated world, centered on the base height");
+
+typedef voxigen::RegularGrid<voxigen::Cell, 64, 64, 16> World;
+typedef voxigen::EquiRectWorldGenerator<World> WorldGenerator;
+typedef World::ChunkType ChunkType;
+typedef std::unique_ptr<ChunkType> UniqueChunk;
+
+struct Mesher
+{
+    const char *name;
+    voxigen::MeshBuilder builder;
+    bool neighbors; //mesh against the attached neighbors
+};
+
+const std::vector<Mesher> meshers=
+{
+    {"cubic", voxigen::MeshBuilder::Cubic, false},
+    {"greedy", voxigen::MeshBuilder::Greedy, false},
+    {"bitmask", voxigen::MeshBuilder::Bitmask, false},
+    {"layered", voxigen::MeshBuilder::Layered, false},
+    {"padded", voxigen::MeshBuilder::Cubic, true},
+    {"paddedGreedy", voxigen::MeshBuilder::Greedy, true},
+    {"bitmaskNeighbors", voxigen::MeshBuilder::Bitmask, true}
+};
+
+//set of chunks meshed together, neighbors follow the Chunk::setNeighbor face order
+struct Corpus
+{
+    std::string name;
+    std::vector<UniqueChunk> chunks;
+    std::vector<std::array<ChunkType *, 6>> neighbors;
+
+    //owned by the corpus but not meshed (empty chunks, air around synthetic chunks)
+    std::vector<UniqueChunk> neighborChunks;
+};
+
+struct Result
+{
+    double seconds;
+    size_t chunks;
+    size_t faces;
+    size_t bytes;
+};
+
+enum class Pattern
+{
+    Checkerboard,
+    Solid,
+    Terrain
+};
+
+std::vector<std::string> split(const std::string &value)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(value);
+    std::string item;
+
+    while(std::getline(stream, item, ','))
+    {
+        if(!item.empty())
+            items.push_back(item);
+    }
+    return items;
+}
+
+glm::ivec3 lodSize(size_t lod)
+{
+    int stride=1<<lod;
+
+    return glm::ivec3(ChunkType::sizeX::value/stride, ChunkType::sizeY::value/stride, ChunkType::sizeZ::value/stride);
+}
+
+UniqueChunk buildPatternChunk(Pattern pattern, size_t lod, size_t variant)
+{
+    glm::ivec3 size=lodSize(lod);
+
+    if(pattern==Pattern::Solid)
+    {
+        UniqueChunk chunk=std::make_unique<ChunkType>(0, 0, glm::ivec3(0, 0, 0), glm::vec3(0.0f, 0.0f, 0.0f), lod, false);
+        voxigen::Cell cell={};
+
+        cell.type=(unsigned int)(variant%3)+1;
+        chunk->setUniform(cell);
+        chunk->setValidCellCount(size.x*size.y*size.z);
+        return chunk;
+    }
+
+    UniqueChunk chunk=std::make_unique<ChunkType>(0, 0, glm::ivec3(0, 0, 0), glm::vec3(0.0f, 0.0f, 0.0f), lod);
+    ChunkType::Cells &cells=chunk->getCells();
+    unsigned int validCells=0;
+    size_t index=0;
+
+    for(int z=0; z<size.z; ++z)
+    {
+        for(int y=0; y<size.y; ++y)
+        {
+            for(int x=0; x<size.x; ++x)
+            {
+                voxigen::Cell &cell=cells[index++];
+
+                cell=voxigen::Cell();
+                if(pattern==Pattern::Checkerboard)
+                {
+                    if(((x+y+z+variant)&1)!=0)
+                        cell.type=1;
+                }
+                else
+                {
+                    //rolling heightfield, phase shifted per variant, 3 layers of types
+                    float phase=(float)variant*0.7f;
+                    float wave=std::sin((x*0.2f)+phase)*std::cos((y*0.15f)+phase);
+                    int height=(int)((0.5f+(0.35f*wave))*size.z);
+
+                    if(z<height-2)
+                        cell.type=3;
+                    else if(z<height-1)
+                        cell.type=2;
+                    else if(z<height)
+                        cell.type=1;
+                }
+
+                if(cell.type!=0)
+                    validCells++;
+            }
+        }
+    }
+
+    chunk->setValidCellCount(validCells);
+    return chunk;
+}
+
+void buildPatternCorpus(Corpus &corpus, const char *name, Pattern pattern, size_t lod, size_t count)
+{
+    corpus.name=name;
+
+    //padded meshers see air on every side
+    UniqueChunk air=std::make_unique<ChunkType>(0, 0, glm::ivec3(0, 0, 0), glm::vec3(0.0f, 0.0f, 0.0f), lod, false);
+
+    air->setUniform(voxigen::Cell());
+
+    std::array<ChunkType *, 6> neighbors;
+
+    neighbors.fill(air.get());
+    corpus.neighborChunks.push_back(std::move(air));
+
+    for(size_t i=0; i<count; ++i)
+    {
+        corpus.chunks.push_back(buildPatternChunk(pattern, lod, i));
+        corpus.neighbors.push_back(neighbors);
+    }
+}
+
+//block of world_columns^2 columns, world_layers chunks high, from the middle of the world
+void buildWorldCorpus(Corpus &corpus, WorldGenerator &generator, const voxigen::GridDescriptors<World> &descriptors, size_t lod)
+{
+    corpus.name="world";
+
+    glm::ivec3 chunkSize(ChunkType::sizeX::value, ChunkType::sizeY::value, ChunkType::sizeZ::value);
+    glm::ivec3 blockSize(FLAGS_world_columns, FLAGS_world_columns, FLAGS_world_layers);
+    glm::ivec3 worldMiddle=descriptors.m_size/2;
+    int baseHeight=generator.getBaseHeight(glm::vec2(worldMiddle.x, worldMiddle.y));
+
+    glm::ivec3 startIndex=worldMiddle/chunkSize-glm::ivec3(blockSize.x/2, blockSize.y/2, 0);
+
+    startIndex.z=(baseHeight/chunkSize.z)-(blockSize.z/2);
+    startIndex.z=std::max(std::min(startIndex.z, (descriptors.m_size.z/chunkSize.z)-blockSize.z), 0);
+
+    size_t cellCount=(ChunkType::sizeX::value*ChunkType::sizeY::value*ChunkType::sizeZ::value)/(lod+1);
+    ChunkType::Cells scratchCells;
+    std::vector<ChunkType *> block(blockSize.x*blockSize.y*blockSize.z, nullptr);
+    std::vector<UniqueChunk> blockChunks(block.size());
+    size_t blockIndex=0;
+
+    for(int z=0; z<blockSize.z; ++z)
+    {
+        for(int y=0; y<blockSize.y; ++y)
+        {
+            for(int x=0; x<blockSize.x; ++x)
+            {
+                glm::ivec3 chunkIndex=startIndex+glm::ivec3(x, y, z);
+                glm::vec3 startPos=glm::vec3(chunkIndex*chunkSize);
+                UniqueChunk chunk=std::make_unique<ChunkType>(0, 0, chunkIndex, startPos, lod, false);
+                bool uniform=false;
+
+                scratchCells.resize(cellCount);
+
+                unsigned int validCells=generator.generateChunk(startPos, chunkSize, scratchCells.data(), scratchCells.size()*sizeof(ChunkType::CellType), lod, uniform);
+
+                if(validCells>0)
+                {
+                    if(uniform)
+                        chunk->setUniform(scratchCells[0]);
+                    else
+                        chunk->getCells().swap(scratchCells);
+                }
+                else
+                    chunk->setUniform(voxigen::Cell());
+
+                chunk->setValidCellCount(validCells);
+                chunk->pack();
+
+                block[blockIndex]=chunk.get();
+                blockChunks[blockIndex]=std::move(chunk);
+                blockIndex++;
+            }
+        }
+    }
+
+    glm::ivec3 pitch(1, blockSize.x, blockSize.x*blockSize.y);
+
+    blockIndex=0;
+    for(int z=0; z<blockSize.z; ++z)
+    {
+        for(int y=0; y<blockSize.y; ++y)
+        {
+            for(int x=0; x<blockSize.x; ++x)
+            {
+                UniqueChunk &chunk=blockChunks[blockIndex];
+                glm::ivec3 position(x, y, z);
+                std::array<ChunkType *, 6> neighbors;
+
+                //chunks on the block boundary have no neighbor on that side
+                for(size_t face=0; face<6; ++face)
+                {
+                    size_t axis=face/2;
+                    glm::ivec3 neighborPos=position;
+
+                    neighborPos[axis]+=((face&1)!=0)?1:-1;
+
+                    if((neighborPos[axis]<0)||(neighborPos[axis]>=blockSize[axis]))
+                        neighbors[face]=nullptr;
+                    else
+                        neighbors[face]=block[(neighborPos.z*pitch.z)+(neighborPos.y*pitch.y)+neighborPos.x];
+                }
+
+                //the renderer does not mesh empty chunks
+                if(chunk->validCellCount()>0)
+                {
+                    corpus.chunks.push_back(std::move(chunk));
+                    corpus.neighbors.push_back(neighbors);
+                }
+                else
+                    corpus.neighborChunks.push_back(std::move(chunk));
+                blockIndex++;
+            }
+        }
+    }
+}
+
+Result benchmark(const Mesher &mesher, Corpus &corpus, voxigen::ChunkTextureMesh &mesh)
+{
+    Result result={0.0, 0, 0, 0};
+
+    for(size_t i=0; i<corpus.chunks.size(); ++i)
+    {
+        ChunkType *chunk=corpus.chunks[i].get();
+
+        for(size_t face=0; face<6; ++face)
+            chunk->setNeighbor(face, mesher.neighbors?corpus.neighbors[i][face]:nullptr);
+    }
+
+    //first pass warms up the scratch buffers and gives the mesh sizes
+    for(UniqueChunk &chunk:corpus.chunks)
+    {
+        mesh.clear();
+        voxigen::buildMesh(mesher.builder, mesh, chunk.get());
+
+        result.faces+=mesh.getVertexCount()/4;
+        result.bytes+=mesh.memoryUsed();
+    }
+
+    auto startTime=std::chrono::high_resolution_clock::now();
+
+    for(int iteration=0; iteration<FLAGS_iterations; ++iteration)
+    {
+        for(UniqueChunk &chunk:corpus.chunks)
+        {
+            mesh.clear();
+            voxigen::buildMesh(mesher.builder, mesh, chunk.get());
+        }
+    }
+
+    auto endTime=std::chrono::high_resolution_clock::now();
+
+    result.seconds=std::chrono::duration<double>(endTime-startTime).count();
+    result.chunks=corpus.chunks.size()*FLAGS_iterations;
+
+    for(UniqueChunk &chunk:corpus.chunks)
+        chunk->clearNeighbors();
+
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    gflags::SetUsageMessage("Meshes a corpus of chunks with each mesh builder, no rendering context is needed");
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    std::vector<size_t> lods;
+
+    for(const std::string &lod:split(FLAGS_lods))
+    {
+        size_t value=std::stoul(lod);
+
+        //lod cells have to fit the chunk
+        if((ChunkType::sizeZ::value>>value)==0)
+        {
+            printf("Skipping lod %zu, chunk is too small\n", value);
+            continue;
+        }
+        lods.push_back(value);
+    }
+
+    std::vector<Mesher> selectedMeshers;
+
+    if(FLAGS_meshers=="all")
+        selectedMeshers=meshers;
+    else
+    {
+        for(const std::string &name:split(FLAGS_meshers))
+        {
+            bool found=false;
+
+            for(const Mesher &mesher:meshers)
+            {
+                if(name==mesher.name)
+                {
+                    selectedMeshers.push_back(mesher);
+                    found=true;
+                }
+            }
+
+            if(!found)
+                printf("Unknown mesher %s\n", name.c_str());
+        }
+    }
+
+    voxigen::GridDescriptors<World> descriptors;
+    WorldGenerator generator;
+
+    if(FLAGS_world)
+    {
+        LoadProgress progress;
+
+        //same size as the test app world
+        descriptors.create("meshBenchmark", FLAGS_world_seed, glm::ivec3(204800, 102400, 10240));
+        descriptors.m_generator=WorldGenerator::typeName();
+
+        printf("Generating world overview...\n");
+        generator.loadDescriptors(&descriptors);
+        generator.generateWorldOverview(progress);
+    }
+
+    //no atlas images are loaded, every cell type uses the unknown texture entry
+    voxigen::TextureAtlas textureAtlas;
+    voxigen::ChunkTextureMesh::FaceTable faceTable;
+    voxigen::ChunkTextureMesh mesh;
+
+    faceTable.build(&textureAtlas);
+    mesh.setFaceTable(&faceTable);
+
+    printf("%-14s %4s %-14s %8s %12s %12s %12s\n", "mesher", "lod", "corpus", "chunks", "chunks/sec", "faces/chunk", "bytes/chunk");
+
+    for(size_t lod:lods)
+    {
+        std::vector<Corpus> corpora(FLAGS_world?4:3);
+
+        buildPatternCorpus(corpora[0], "checkerboard", Pattern::Checkerboard, lod, 2);
+        buildPatternCorpus(corpora[1], "solid", Pattern::Solid, lod, 3);
+        buildPatternCorpus(corpora[2], "terrain", Pattern::Terrain, lod, 8);
+        if(FLAGS_world)
+            buildWorldCorpus(corpora[3], generator, descriptors, lod);
+
+        for(const Mesher &mesher:selectedMeshers)
+        {
+            for(Corpus &corpus:corpora)
+            {
+                if(corpus.chunks.empty())
+                    continue;
+
+                Result result=benchmark(mesher, corpus, mesh);
+                size_t chunkCount=corpus.chunks.size();
+                double chunksPerSecond=(result.seconds>0.0)?result.chunks/result.seconds:0.0;
+
+                printf("%-14s %4zu %-14s %8zu %12.1f %12.1f %12.1f\n", mesher.name, lod, corpus.name.c_str(), chunkCount, chunksPerSecond,
+                    (double)result.faces/chunkCount, (double)result.bytes/chunkCount);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -5,6 +5,7 @@ in vec3 normal;
 in vec2 texCoords;
 in vec3 barycentric;
 flat in uint type;
+flat in ivec4 textureTile;
 out vec4 color;
 
 uniform vec3 lightPos;
@@ -24,7 +25,10 @@ void main()
    float diff=max(dot(normal, lightDir), 0.0); 
    vec3 diffuse=diff * lightColor; 
    
-   color=texelFetch(textureSampler, ivec2(texCoords), 0);
+   //merged faces span more than one tile, wrap back into the tile
+   ivec2 texel=textureTile.xy+ivec2(mod(texCoords-vec2(textureTile.xy), vec2(textureTile.zw)));
+
+   color=texelFetch(textureSampler, texel, 0);
 
    //wireframe
    if(options==1)
@@ -13,6 +13,7 @@ out vec3 normal;
 out vec2 texCoords;
 out vec3 barycentric;
 flat out uint type;
+flat out ivec4 textureTile;
 
 //layout (std140) uniform pos
 //{
@@ -22,6 +23,9 @@ flat out uint type;
 //}
 uniform mat4 projectionView;
 uniform vec3 regionOffset;
+//texture tile (origin, size) per cell type (row) and face (column), types past the
+//atlas use the last row
+uniform usampler2D tileTable;
 
 void main()
 {
@@ -36,6 +40,12 @@ void main()
     texCoords=vec2(vTexCoords.x, vTexCoords.y);
 //   texCoords=vec3(0.0, 0.0, data);
     type=data;
+
+    int axis=(packedNormal.x!=0)?0:((packedNormal.y!=0)?1:2);
+    int face=axis*2+((packedNormal[axis]>0)?1:0);
+    int lastType=textureSize(tileTable, 0).y-1;
+
+    textureTile=ivec4(texelFetch(tileTable, ivec2(face, min(int(data), lastType)), 0));
 //   vec2 normTexCoords=mod(texCoords, 4.0f);
 //   vec2 normTexCoords=mod(texCoords, 32.0f)*32.0f;
 //    vec2 normTexCoords=(texCoords/32.0f);
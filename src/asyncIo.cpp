@@ -0,0 +1,426 @@
+#include "voxigen/asyncIo.h"
+#include "voxigen/fileio/log.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#ifdef VOXIGEN_IO_URING
+#include <liburing.h>
+#endif
+
+namespace voxigen
+{
+
+#ifdef VOXIGEN_IO_URING
+const size_t RingSubmitRetries=16;
+const long long RingWaitTimeout=100000000; //ns
+
+struct AsyncIo::Ring
+{
+    struct Slot
+    {
+        Slot():request(nullptr) {}
+
+        process::Request *request;
+        IoOperation operation;
+    };
+
+    io_uring ring;
+
+    //sqe side is shared by the pool threads, cqe side is only used by the ring thread
+    std::mutex mutex;
+    std::condition_variable slotEvent;
+    std::vector<Slot> slots;
+    std::vector<size_t> freeSlots;
+    bool run;
+};
+#else
+struct AsyncIo::Ring
+{};
+#endif
+
+AsyncIo::AsyncIo(std::condition_variable *completeEvent):
+    m_queueThread(completeEvent)
+{
+    m_queueThread.setCallback(std::bind(&AsyncIo::processRequest, this, std::placeholders::_1));
+
+    processCallback=std::bind(&AsyncIo::defaultCallback, this, std::placeholders::_1);
+    prepareCallback=std::bind(&AsyncIo::defaultPrepare, this, std::placeholders::_1, std::placeholders::_2);
+    completeCallback=std::bind(&AsyncIo::defaultComplete, this, std::placeholders::_1, std::placeholders::_2);
+}
+
+AsyncIo::~AsyncIo()
+{
+}
+
+void AsyncIo::setCallback(process::Callback callback)
+{
+    processCallback=callback;
+}
+
+void AsyncIo::setAsyncCallbacks(PrepareCallback prepare, CompleteCallback complete)
+{
+    prepareCallback=prepare;
+    completeCallback=complete;
+}
+
+void AsyncIo::start(size_t threadCount, size_t queueDepth)
+{
+    if(!startRing(queueDepth))
+        m_ring.reset();
+
+    //ring completes requests from its own thread
+    m_queueThread.setDeferCompletion(m_ring!=nullptr);
+    m_queueThread.start(threadCount);
+}
+
+void AsyncIo::stop()
+{
+    //stop submitting before shutting down the ring
+    m_queueThread.stop();
+    stopRing();
+    completeReads();
+}
+
+void AsyncIo::updateQueue(RequestQueue &queue, RequestQueue &cancelQueue, RequestQueue &completedQueue, bool forceResort)
+{
+    m_queueThread.updateQueue(queue, cancelQueue, completedQueue, forceResort);
+}
+
+bool AsyncIo::processRequest(process::Request *request)
+{
+    IoOperation operation;
+
+    //read finished on the ring, decode it here
+    if(takeRead(request, operation))
+    {
+        completeCallback(request, operation);
+        return true;
+    }
+
+    if(!prepareCallback(request, operation))
+    {
+        processCallback(request);
+        return true;
+    }
+
+    if(m_ring && submitRing(request, operation))
+        return false; //completed by the ring thread
+
+    readBlocking(operation);
+    completeCallback(request, operation);
+    return true;
+}
+
+void AsyncIo::requeueRead(process::Request *request, IoOperation &operation)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_readMutex);
+
+        m_completedReads[request]=std::move(operation);
+    }
+    m_queueThread.requeueRequest(request);
+}
+
+bool AsyncIo::takeRead(process::Request *request, IoOperation &operation)
+{
+    std::unique_lock<std::mutex> lock(m_readMutex);
+
+    if(m_completedReads.empty())
+        return false;
+
+    auto iter=m_completedReads.find(request);
+
+    if(iter==m_completedReads.end())
+        return false;
+
+    operation=std::move(iter->second);
+    m_completedReads.erase(iter);
+    return true;
+}
+
+void AsyncIo::completeReads()
+{
+    std::unordered_map<process::Request *, IoOperation> completedReads;
+
+    {
+        std::unique_lock<std::mutex> lock(m_readMutex);
+
+        completedReads.swap(m_completedReads);
+    }
+
+    for(auto &completedRead:completedReads)
+    {
+        completeCallback(completedRead.first, completedRead.second);
+        m_queueThread.completeRequest(completedRead.first);
+    }
+}
+
+bool AsyncIo::readBlocking(IoOperation &operation)
+{
+#ifndef _WIN32
+    size_t size=operation.buffer.size();
+    size_t read=0;
+
+    while(read<size)
+    {
+        ssize_t value=pread(operation.file, operation.buffer.data()+read, size-read, operation.offset+read);
+
+        if(value<0)
+        {
+            if(errno==EINTR)
+                continue;
+
+            operation.result=-errno;
+            return false;
+        }
+
+        if(value==0) //end of file
+            break;
+        read+=value;
+    }
+
+    operation.result=read;
+    return (read==size);
+#else
+    operation.result=-1;
+    return false;
+#endif
+}
+
+#ifdef VOXIGEN_IO_URING
+bool AsyncIo::startRing(size_t queueDepth)
+{
+    if(m_ring)
+        return true;
+
+    m_ring=std::make_unique<Ring>();
+
+    //kernel may not support io_uring (or it is blocked), pool threads will do the reads
+    if(io_uring_queue_init((unsigned int)queueDepth, &m_ring->ring, 0)<0)
+    {
+        Log::warning("AsyncIo io_uring not available, using blocking reads");
+        return false;
+    }
+
+    m_ring->slots.resize(queueDepth);
+    m_ring->freeSlots.resize(queueDepth);
+    for(size_t i=0; i<queueDepth; ++i)
+        m_ring->freeSlots[i]=queueDepth-i-1;
+    m_ring->run=true;
+
+    m_ringThread=std::thread(std::bind(&AsyncIo::ringThread, this));
+    return true;
+}
+
+void AsyncIo::stopRing()
+{
+    if(!m_ring)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(m_ring->mutex);
+
+        m_ring->run=false;
+
+        //wake ring thread, it exits once all in flight reads are done. If the nop
+        //can not be queued the ring thread still sees run on its wait timeout
+        io_uring_sqe *sqe=getSqe();
+
+        if(sqe)
+        {
+            io_uring_prep_nop(sqe);
+            io_uring_sqe_set_data(sqe, nullptr);
+            io_uring_submit(&m_ring->ring);
+        }
+    }
+    m_ring->slotEvent.notify_all();
+
+    if(m_ringThread.joinable())
+        m_ringThread.join();
+
+    io_uring_queue_exit(&m_ring->ring);
+    m_ring.reset();
+}
+
+io_uring_sqe *AsyncIo::getSqe()
+{
+    io_uring_sqe *sqe=io_uring_get_sqe(&m_ring->ring);
+
+    //submission queue full, hand the queued entries to the kernel and retry
+    for(size_t i=0; (i<RingSubmitRetries)&&!sqe; ++i)
+    {
+        if(io_uring_submit(&m_ring->ring)<0)
+            std::this_thread::yield();
+        sqe=io_uring_get_sqe(&m_ring->ring);
+    }
+    return sqe;
+}
+
+bool AsyncIo::submitRing(process::Request *request, IoOperation &operation)
+{
+    std::unique_lock<std::mutex> lock(m_ring->mutex);
+
+    //limit reads in flight, pool thread waits for a slot
+    m_ring->slotEvent.wait(lock, [&] { return !m_ring->freeSlots.empty()||!m_ring->run; });
+
+    if(!m_ring->run)
+        return false;
+
+    io_uring_sqe *sqe=getSqe();
+
+    if(!sqe)
+        return false;
+
+    size_t index=m_ring->freeSlots.back();
+    Ring::Slot &slot=m_ring->slots[index];
+
+    m_ring->freeSlots.pop_back();
+
+    slot.request=request;
+    slot.operation=std::move(operation);
+
+    io_uring_prep_read(sqe, slot.operation.file, slot.operation.buffer.data(), (unsigned int)slot.operation.buffer.size(), slot.operation.offset);
+    //slot index+1, 0 is used to stop the thread
+    io_uring_sqe_set_data(sqe, (void *)(index+1));
+    io_uring_submit(&m_ring->ring);
+
+    return true;
+}
+
+void AsyncIo::ringThread()
+{
+    bool stopping=false;
+
+    while(true)
+    {
+        if(stopping)
+        {
+            std::unique_lock<std::mutex> lock(m_ring->mutex);
+
+            if(m_ring->freeSlots.size()==m_ring->slots.size())
+                break;
+        }
+
+        io_uring_cqe *cqe;
+        __kernel_timespec timeout={0, RingWaitTimeout};
+        int error=io_uring_wait_cqe_timeout(&m_ring->ring, &cqe, &timeout);
+
+        if(error<0)
+        {
+            if(error==-EINTR)
+                continue;
+
+            if(error==-ETIME)
+            {
+                //covers a stop nop that could not be queued
+                std::unique_lock<std::mutex> lock(m_ring->mutex);
+
+                if(!m_ring->run)
+                    stopping=true;
+                continue;
+            }
+
+            Log::error("AsyncIo io_uring wait failed %d", error);
+            failRing();
+            break;
+        }
+
+        size_t data=(size_t)io_uring_cqe_get_data(cqe);
+        int result=cqe->res;
+
+        io_uring_cqe_seen(&m_ring->ring, cqe);
+
+        if(data==0)
+        {
+            stopping=true;
+            continue;
+        }
+
+        size_t index=data-1;
+        Ring::Slot &slot=m_ring->slots[index];
+        process::Request *request=slot.request;
+        IoOperation operation=std::move(slot.operation);
+
+        operation.result=result;
+
+        {
+            std::unique_lock<std::mutex> lock(m_ring->mutex);
+
+            slot.request=nullptr;
+            slot.operation=IoOperation();
+            m_ring->freeSlots.push_back(index);
+        }
+        m_ring->slotEvent.notify_one();
+
+        //short read, finish it with a blocking read
+        if((result>=0)&&((size_t)result<operation.buffer.size()))
+            readBlocking(operation);
+
+        requeueRead(request, operation);
+    }
+}
+
+void AsyncIo::failRing()
+{
+    std::vector<Ring::Slot> slots;
+
+    //no more completions will come, pool threads read blocking from here on
+    {
+        std::unique_lock<std::mutex> lock(m_ring->mutex);
+
+        m_ring->run=false;
+        for(size_t i=0; i<m_ring->slots.size(); ++i)
+        {
+            Ring::Slot &slot=m_ring->slots[i];
+
+            if(!slot.request)
+                continue;
+
+            slots.push_back(std::move(slot));
+            slot.request=nullptr;
+            slot.operation=IoOperation();
+            m_ring->freeSlots.push_back(i);
+        }
+    }
+    m_ring->slotEvent.notify_all();
+
+    for(Ring::Slot &slot:slots)
+    {
+        readBlocking(slot.operation);
+        completeCallback(slot.request, slot.operation);
+        m_queueThread.completeRequest(slot.request);
+    }
+}
+#else
+io_uring_sqe *AsyncIo::getSqe()
+{
+    return nullptr;
+}
+
+bool AsyncIo::startRing(size_t queueDepth)
+{
+    return false;
+}
+
+void AsyncIo::stopRing()
+{
+}
+
+bool AsyncIo::submitRing(process::Request *request, IoOperation &operation)
+{
+    return false;
+}
+
+void AsyncIo::ringThread()
+{
+}
+
+void AsyncIo::failRing()
+{
+}
+#endif//VOXIGEN_IO_URING
+
+}//namespace voxigen
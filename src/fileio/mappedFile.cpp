@@ -0,0 +1,131 @@
+#include "voxigen/fileio/mappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace voxigen
+{
+
+MappedFile::MappedFile():
+#ifdef _WIN32
+m_file(INVALID_HANDLE_VALUE),
+m_mapping(nullptr),
+#else
+m_file(-1),
+#endif
+m_data(nullptr),
+m_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+bool MappedFile::open(const std::string &fileName)
+{
+    close();
+
+    m_file=CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ|FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if(m_file==INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+
+    if(!GetFileSizeEx(m_file, &fileSize)||(fileSize.QuadPart==0))
+    {
+        close();
+        return false;
+    }
+
+    m_mapping=CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if(m_mapping==nullptr)
+    {
+        close();
+        return false;
+    }
+
+    m_data=(const char *)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if(m_data==nullptr)
+    {
+        close();
+        return false;
+    }
+
+    m_size=(size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(m_data!=nullptr)
+        UnmapViewOfFile(m_data);
+    if(m_mapping!=nullptr)
+        CloseHandle(m_mapping);
+    if(m_file!=INVALID_HANDLE_VALUE)
+        CloseHandle(m_file);
+
+    m_file=INVALID_HANDLE_VALUE;
+    m_mapping=nullptr;
+    m_data=nullptr;
+    m_size=0;
+}
+#else
+bool MappedFile::open(const std::string &fileName)
+{
+    close();
+
+    m_file=::open(fileName.c_str(), O_RDONLY);
+
+    if(m_file<0)
+        return false;
+
+    struct stat fileStat;
+
+    if((fstat(m_file, &fileStat)!=0)||(fileStat.st_size==0))
+    {
+        close();
+        return false;
+    }
+
+    void *data=mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, m_file, 0);
+
+    if(data==MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+
+    m_data=(const char *)data;
+    m_size=(size_t)fileStat.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(m_data!=nullptr)
+        munmap((void *)m_data, m_size);
+    if(m_file>=0)
+        ::close(m_file);
+
+    m_file=-1;
+    m_data=nullptr;
+    m_size=0;
+}
+#endif
+
+} //namespace voxigen
@@ -2,6 +2,7 @@
 #include "voxigen/fileio/filesystem.h"
 
 #include <cstring>
+#include <algorithm>
 
 namespace voxigen
 {
@@ -51,6 +52,32 @@ void copy_file(const char *src, const char *dest, bool replace)
 #endif
 }
 
+bool rename(const char *src, const char *dest)
+{
+    ::fs::path srcPath(src);
+    ::fs::path destPath(dest);
+#if VOXIGEN_USE_FILESYSTEM == 0
+    boost::system::error_code error;
+#else
+    std::error_code error;
+#endif
+
+    ::fs::rename(srcPath, destPath, error);
+    return !error;
+}
+
+bool remove(const char *name)
+{
+    ::fs::path path(name);
+#if VOXIGEN_USE_FILESYSTEM == 0
+    boost::system::error_code error;
+#else
+    std::error_code error;
+#endif
+
+    return ::fs::remove(path, error);
+}
+
 void VOXIGEN_EXPORT extension(const char *file, char *value, size_t &size)
 {
     ::fs::path path(file);
@@ -95,4 +122,33 @@ void VOXIGEN_EXPORT get_directories(const char *directory, char **directoriePath
     }
 }
 
+//size is the capacity of files/sizes when they are given, returns the file count
+void VOXIGEN_EXPORT get_files(const char *directory, char **filePaths, size_t *sizes, size_t &size)
+{
+    std::vector<std::string> files;
+    ::fs::path directoryPath(directory);
+    size_t capacity=size;
+
+    for(auto &entry : ::fs::directory_iterator(directoryPath))
+    {
+        if(::fs::is_regular_file(entry.path()))
+            files.push_back(entry.path().filename().string());
+    }
+
+    size=files.size();
+    if(sizes!=nullptr)
+    {
+        //directory may have changed between calls
+        size_t count=std::min(files.size(), capacity);
+
+        for(size_t i=0; i<count; ++i)
+        {
+            if((filePaths!=nullptr) && (files[i].size()<=sizes[i]))
+                std::memcpy((void *)filePaths[i], files[i].data(), files[i].size());
+            sizes[i]=files[i].size();
+        }
+        size=count;
+    }
+}
+
 }}//namespace voxigen::fs
@@ -58,7 +58,12 @@ void ProcessThread::setSizes(glm::ivec3 &regionSize, glm::ivec3 &chunkSize)
 
 void ProcessThread::setIoRequestCallback(process::Callback callback)
 {
-    m_workerThread.setCallback(callback);
+    m_ioThread.setCallback(callback);
+}
+
+void ProcessThread::setIoAsyncCallbacks(AsyncIo::PrepareCallback prepare, AsyncIo::CompleteCallback complete)
+{
+    m_ioThread.setAsyncCallbacks(prepare, complete);
 }
 
 void ProcessThread::setChunkRequestCallback(process::Callback callback)
@@ -82,6 +87,10 @@ void ProcessThread::updateQueues(RequestQueue &completedRequests)
         //send all cached request to coordination thread
         if(!m_requestQueue.empty())
         {
+            for(process::Request *request:m_requestQueue)
+                m_inFlightRequests[getRequestKey(request)]=request;
+            m_pendingRequests.clear();
+
             m_requestThreadQueue.insert(m_requestThreadQueue.end(), m_requestQueue.begin(), m_requestQueue.end());
             m_requestQueue.clear();
 //#ifdef DEBUG_THREAD
@@ -99,6 +108,15 @@ void ProcessThread::updateQueues(RequestQueue &completedRequests)
         }
     }
 
+    for(process::Request *request:completedRequests)
+    {
+        auto iter=m_inFlightRequests.find(getRequestKey(request));
+
+        //a newer request for the same object may have replaced it
+        if((iter!=m_inFlightRequests.end()) && (iter->second==request))
+            m_inFlightRequests.erase(iter);
+    }
+
     if(update)
         m_event.notify_all();
 }
@@ -111,18 +129,20 @@ void ProcessThread::start()
         m_run=true;
     }
 
-    m_thread=std::thread(std::bind(&ProcessThread::processThread, this));
-
-    m_ioThread.start();
+    //reads are mostly waiting on the disk (or the ring), a few threads keep many in flight
+    m_ioThread.start(4, 64);
 
     //want the number of physical processors vs threads
 //    int hardwareThreads=std::thread::hardware_concurrency()-1;
     int hardwareThreads=getProcessorCount()-1;
 
-    if(hardwareThreads<0)
+    if(hardwareThreads<1)
         hardwareThreads=1;
 
+    //workers need to exist before the coordination thread hands them requests
     m_workerThread.start(hardwareThreads);
+
+    m_thread=std::thread(std::bind(&ProcessThread::processThread, this));
 }
 
 
@@ -142,6 +162,16 @@ void ProcessThread::stop()
 
 bool ProcessThread::updatePosition(const glm::ivec3 &region, const glm::ivec3 &chunk)
 {
+    auto iter=m_pendingRequests.find(RequestKey(nullptr, process::Type::UpdatePos));
+
+    //only the latest position matters
+    if(iter!=m_pendingRequests.end())
+    {
+        iter->second->position.region=region;
+        iter->second->position.chunk=chunk;
+        return true;
+    }
+
     process::Request *request=getRequest();
 
 #ifdef DEBUG_REQUESTS
@@ -163,6 +193,29 @@ bool ProcessThread::updatePosition(const glm::ivec3 &region, const glm::ivec3 &c
 
 bool ProcessThread::requestMeshAction(process::Type type, size_t priority, void *renderer, void *mesh, const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex)
 {
+    RequestKey key(renderer, type);
+
+    //a queued mesh request is not dropped by a cancel as its mesh has to be handed back,
+    //a new mesh request drops a queued cancel
+    if(type==process::Type::Mesh)
+        dropPendingRequest(RequestKey(renderer, process::Type::CancelMesh));
+
+    auto iter=m_pendingRequests.find(key);
+
+    //merge into the queued request, unless it is for a different mesh as that mesh
+    //would never be handed back
+    if((iter!=m_pendingRequests.end()) && (iter->second->data.buildMesh.mesh==mesh))
+    {
+        iter->second->priority=priority;
+        iter->second->position.region=regionIndex;
+        iter->second->position.chunk=chunkIndex;
+        return true;
+    }
+
+    iter=m_inFlightRequests.find(key);
+    if((iter!=m_inFlightRequests.end()) && (iter->second->data.buildMesh.mesh==mesh))
+        return true; //already being built
+
     process::Request *request=getRequest();
 
 #ifdef DEBUG_REQUESTS
@@ -187,6 +240,31 @@ bool ProcessThread::requestMeshAction(process::Type type, size_t priority, void
 
 bool ProcessThread::requestChunkAction(process::Type type, size_t priority, void *chunkHandle, size_t lod, const glm::ivec3 &regionIndex, const glm::ivec3 &chunkIndex)
 {
+    RequestKey key(chunkHandle, type);
+    RequestKey oppositeKey(chunkHandle, oppositeType(type));
+
+    //a cancel for a request that has not been sent yet just drops it (the cancel is still
+    //sent if an older one is in flight), a request drops a queued cancel as it is wanted again
+    if(dropPendingRequest(oppositeKey) && isCancel(type) && (m_inFlightRequests.find(oppositeKey)==m_inFlightRequests.end()))
+        return true;
+
+    auto iter=m_pendingRequests.find(key);
+
+    //not sent yet, merge into the queued request
+    if(iter!=m_pendingRequests.end())
+    {
+        iter->second->priority=priority;
+        iter->second->position.region=regionIndex;
+        iter->second->position.chunk=chunkIndex;
+        iter->second->data.chunk.lod=lod;
+        return true;
+    }
+
+    //already being worked on at this lod, the threads own it so leave it as is
+    iter=m_inFlightRequests.find(key);
+    if((iter!=m_inFlightRequests.end()) && (iter->second->data.chunk.lod==lod))
+        return true;
+
     process::Request *request=getRequest();
 
 #ifdef DEBUG_REQUESTS
@@ -213,7 +291,14 @@ process::Request *ProcessThread::getRequest()
 {
     assert(checkRequestThread());
 
-    return m_requests.get();
+    process::Request *request=m_requests.get();
+
+    if(request)
+    {
+        request->result=process::Result::Success;
+        request->batch=nullptr;
+    }
+    return request;
 }
 
 void ProcessThread::insertRequest(process::Request *request)
@@ -223,9 +308,105 @@ void ProcessThread::insertRequest(process::Request *request)
     assert(std::find(m_requestQueue.begin(), m_requestQueue.end(), request)==m_requestQueue.end());
 
     m_requestQueue.push_back(request);
+    m_pendingRequests[getRequestKey(request)]=request;
     m_event.notify_all();
 }
 
+bool ProcessThread::dropPendingRequest(const RequestKey &key)
+{
+    auto iter=m_pendingRequests.find(key);
+
+    if(iter==m_pendingRequests.end())
+        return false;
+
+    process::Request *request=iter->second;
+    auto queueIter=std::find(m_requestQueue.begin(), m_requestQueue.end(), request);
+
+    assert(queueIter!=m_requestQueue.end());
+    m_requestQueue.erase(queueIter);
+    m_pendingRequests.erase(iter);
+
+    if(isCancel(request->type))
+    {
+        releaseRequest(request);
+        return true;
+    }
+
+    //hand it back as canceled so the owner sees it finish
+    request->result=process::Result::Canceled;
+    {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+
+        m_requestsComplete.push_back(request);
+    }
+    return true;
+}
+
+process::Type ProcessThread::oppositeType(process::Type type)
+{
+    switch(type)
+    {
+    case process::Type::GenerateRegion:
+        return process::Type::CancelGenerateRegion;
+    case process::Type::CancelGenerateRegion:
+        return process::Type::GenerateRegion;
+    case process::Type::Generate:
+        return process::Type::CancelGenerate;
+    case process::Type::CancelGenerate:
+        return process::Type::Generate;
+    case process::Type::Read:
+        return process::Type::CancelRead;
+    case process::Type::CancelRead:
+        return process::Type::Read;
+    case process::Type::Write:
+        return process::Type::CancelWrite;
+    case process::Type::CancelWrite:
+        return process::Type::Write;
+    case process::Type::Mesh:
+        return process::Type::CancelMesh;
+    case process::Type::CancelMesh:
+        return process::Type::Mesh;
+    default:
+        break;
+    }
+    return type;
+}
+
+bool ProcessThread::isCancel(process::Type type)
+{
+    switch(type)
+    {
+    case process::Type::CancelGenerateRegion:
+    case process::Type::CancelGenerate:
+    case process::Type::CancelRead:
+    case process::Type::CancelWrite:
+    case process::Type::CancelMesh:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+ProcessThread::RequestKey ProcessThread::getRequestKey(process::Request *request)
+{
+    switch(request->type)
+    {
+    case process::Type::UpdatePos:
+        return RequestKey(nullptr, request->type);
+    case process::Type::GenerateRegion:
+    case process::Type::CancelGenerateRegion:
+        return RequestKey(request->data.region.handle, request->type);
+    case process::Type::Mesh:
+    case process::Type::CancelMesh:
+    case process::Type::MeshReturn:
+        return RequestKey(request->data.buildMesh.renderer, request->type);
+    default:
+        break;
+    }
+    return RequestKey(request->data.chunk.handle, request->type);
+}
+
 void ProcessThread::releaseRequest(process::Request *request)
 {
     assert(checkRequestThread());
@@ -246,6 +427,7 @@ void ProcessThread::processThread()
     RequestQueue workerQueue;
     RequestQueue workerCancelQueue;
     RequestQueue meshWaitQueue;
+    ColumnMap generateColumns;
 
 //    RequestQueue priorityQueue;
 
@@ -305,8 +487,27 @@ void ProcessThread::processThread()
             case process::Type::CancelRead:
             case process::Type::CancelWrite:
                 ioCancelQueue.push_back(request);
+                break;
             case process::Type::Generate:
-                workerQueue.push_back(request);
+                {
+                    //chunks of the same column and lod are generated as one batch so the
+                    //generator only does the 2d work once (Generator::generateChunks)
+                    ColumnKey key(request);
+                    auto iter=generateColumns.find(key);
+
+                    if(iter!=generateColumns.end())
+                    {
+                        process::Request *leader=iter->second;
+
+                        request->batch=leader->batch;
+                        leader->batch=request;
+                    }
+                    else
+                    {
+                        generateColumns[key]=request;
+                        workerQueue.push_back(request);
+                    }
+                }
                 break;
             case process::Type::Mesh:
                 {
@@ -335,6 +536,7 @@ void ProcessThread::processThread()
             }
         }
         requestQueue.clear();
+        generateColumns.clear();
 
         bool forceResort=false;
         //process updates
@@ -374,6 +576,34 @@ void ProcessThread::processThread()
 //#endif//DEBUG_RENDERERS
         m_workerThread.updateQueue(workerQueue, workerCancelQueue, completedQueue, forceResort);
         assert(workerQueue.size()==0);
+
+        completeBatches(completedQueue, requestQueue);
+    }
+}
+
+void ProcessThread::completeBatches(RequestQueue &completedQueue, RequestQueue &requestQueue)
+{
+    size_t count=completedQueue.size();
+
+    for(size_t i=0; i<count; ++i)
+    {
+        process::Request *request=completedQueue[i];
+        process::Request *next=request->batch;
+
+        request->batch=nullptr;
+        while(next)
+        {
+            process::Request *batchRequest=next;
+
+            next=batchRequest->batch;
+            batchRequest->batch=nullptr;
+
+            //only the first request was canceled, the rest still need generating
+            if(request->result==process::Result::Canceled)
+                requestQueue.push_back(batchRequest);
+            else
+                completedQueue.push_back(batchRequest);
+        }
     }
 }
 
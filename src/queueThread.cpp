@@ -5,7 +5,9 @@ namespace voxigen
 {
 
 QueueThread::QueueThread(std::condition_variable *completeEvent):
-    m_completeEvent(completeEvent)
+    m_completeEvent(completeEvent),
+    m_run(false),
+    m_deferCompletion(false)
 {
     processRequest=std::bind(&QueueThread::defaultCallback, this, std::placeholders::_1
 );
@@ -16,11 +18,35 @@ void QueueThread::setCallback(process::Callback callback)
     processRequest=callback;
 }
 
+void QueueThread::completeRequest(process::Request *request)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+#ifdef DEBUG_THREAD
+        Log::debug("ProcessThread deferred request complete %llx", request);
+#endif//DEBUG_THREAD
+        m_completedQueue.push_back(request);
+    }
+    m_completeEvent->notify_all();
+}
+
+void QueueThread::requeueRequest(process::Request *request)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_requeued.push_back(request);
+    }
+    m_event.notify_one();
+}
+
 void QueueThread::start(size_t threadCount)
 {
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         m_run=true;
+        m_requeued.clear();
     }
 
     //create 
@@ -43,6 +69,11 @@ void QueueThread::stop()
     m_event.notify_all();
     for(unsigned int i=0; i<m_threads.size(); ++i)
         m_threads[i].join();
+    m_threads.clear();
+
+    //owner completes anything it requeued after the threads stopped
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_requeued.clear();
 }
 
 void QueueThread::updateQueue(RequestQueue &queue, RequestQueue &cancelQueue, RequestQueue &completedQueue, bool forceResort)
@@ -116,7 +147,12 @@ void QueueThread::process()
                 request=nullptr;
             }
 
-            if(!m_queue.empty())
+            if(!m_requeued.empty())
+            {
+                request=m_requeued.back();
+                m_requeued.pop_back();
+            }
+            else if(!m_queue.empty())
             {
                 std::pop_heap(m_queue.begin(), m_queue.end(), process::Compare());
                 request=m_queue.back();
@@ -132,7 +168,11 @@ void QueueThread::process()
 #ifdef DEBUG_THREAD
         Log::debug("ProcessThread processing request %llx", request);
 #endif//DEBUG_THREAD
-        processRequest(request);
+        bool complete=processRequest(request);
+
+        //request still in flight, owner will call completeRequest
+        if(m_deferCompletion && !complete)
+            request=nullptr;
     }
 }
 
@@ -50,8 +50,12 @@ namespace voxigen
 //};
 
 TextureAtlas::TextureAtlas(size_t maxTextureWidth, size_t maxTextureHeight):
+m_version(0),
 m_maxTextureWidth(maxTextureWidth),
-m_maxTextureHeight(maxTextureHeight)
+m_maxTextureHeight(maxTextureHeight),
+m_width(0),
+m_height(0),
+m_textureResolution(0)
 {}
 
 TextureAtlas::~TextureAtlas()
@@ -0,0 +1,505 @@
+#include "voxigen/volume/regionPack.h"
+#include "voxigen/fileio/simpleFilesystem.h"
+#include "voxigen/fileio/log.h"
+
+#include <cstring>
+#include <cassert>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace voxigen
+{
+
+inline uint64_t alignPackOffset(uint64_t offset)
+{
+    return (offset+RegionPack_Alignment-1)&~(uint64_t)(RegionPack_Alignment-1);
+}
+
+RegionPack::RegionPack():
+m_open(false),
+m_nativeFile(-1),
+m_pendingReads(0),
+m_dataOffset(0),
+m_fileEnd(0),
+m_unused(0)
+{
+    m_header.marker=RegionPackHeader_Marker;
+    m_header.version=RegionPackHeader_Version;
+    m_header.chunkCount=0;
+    m_header.reserved=0;
+}
+
+RegionPack::~RegionPack()
+{
+    close();
+}
+
+void RegionPack::setFile(const std::string &fileName, size_t chunkCount)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    assert(!m_open);
+    m_fileName=fileName;
+    m_header.chunkCount=(unsigned int)chunkCount;
+    m_dataOffset=alignPackOffset(sizeof(RegionPackHeader)+chunkCount*sizeof(RegionPackEntry));
+}
+
+bool RegionPack::open(bool create)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return openFile(create);
+}
+
+bool RegionPack::openFile(bool create)
+{
+    if(m_open)
+        return true;
+
+    if(m_fileName.empty())
+        return false;
+
+    if(!fs::exists(m_fileName))
+    {
+        if(!create)
+            return false;
+
+        if(!createFile())
+            return false;
+    }
+
+    m_file.open(m_fileName, std::fstream::in|std::fstream::out|std::fstream::binary);
+
+    if(!m_file.is_open())
+        return false;
+
+    if(m_entries.empty())
+    {
+        if(!readTable())
+        {
+            m_file.close();
+
+            if(!create)
+            {
+                Log::warning("RegionPack %s damaged or old version, chunks will be regenerated", m_fileName.c_str());
+                return false;
+            }
+
+            //keep the bad pack around and start a new one, otherwise every write would fail
+            std::string badFileName=m_fileName+".bad";
+
+            Log::warning("RegionPack %s damaged or old version, moved to %s", m_fileName.c_str(), badFileName.c_str());
+            fs::remove(badFileName);
+            if(!fs::rename(m_fileName, badFileName))
+                fs::remove(m_fileName);
+
+            if(!createFile())
+                return false;
+
+            m_file.open(m_fileName, std::fstream::in|std::fstream::out|std::fstream::binary);
+            if(!m_file.is_open())
+                return false;
+        }
+        else if((m_unused>RegionPack_CompactMinimum)&&(m_unused>(m_fileEnd-m_dataOffset)/2))
+            compact();
+    }
+
+    m_open=true;
+    return true;
+}
+
+bool RegionPack::createFile()
+{
+    size_t pos=m_fileName.find_last_of("/\\");
+
+    if(pos!=std::string::npos)
+    {
+        std::string directory=m_fileName.substr(0, pos);
+
+        if(!fs::is_directory(directory))
+            fs::create_directory(directory);
+    }
+
+    //new pack, write header and empty table
+    std::ofstream file;
+
+    m_entries.assign(m_header.chunkCount, RegionPackEntry{0, 0, 0, 0, 0});
+
+    file.open(m_fileName, std::ofstream::out|std::ofstream::trunc|std::ofstream::binary);
+    if(!file.is_open())
+    {
+        m_entries.clear();
+        return false;
+    }
+
+    file.write((char *)&m_header, sizeof(RegionPackHeader));
+    file.write((char *)m_entries.data(), m_entries.size()*sizeof(RegionPackEntry));
+
+    std::vector<char> padding(m_dataOffset-(sizeof(RegionPackHeader)+m_entries.size()*sizeof(RegionPackEntry)), 0);
+
+    if(!padding.empty())
+        file.write(padding.data(), padding.size());
+    file.close();
+
+    m_fileEnd=m_dataOffset;
+    m_unused=0;
+    return true;
+}
+
+bool RegionPack::readTable()
+{
+    RegionPackHeader header;
+
+    m_file.seekg(0, std::fstream::end);
+    m_fileEnd=m_file.tellg();
+    m_file.seekg(0, std::fstream::beg);
+
+    //header and table are at the front so one read gets both
+    std::vector<char> buffer(m_dataOffset);
+
+    if(m_fileEnd<m_dataOffset)
+        return false;
+
+    m_file.read(buffer.data(), buffer.size());
+    if(!m_file)
+    {
+        m_file.clear();
+        return false;
+    }
+
+    memcpy(&header, buffer.data(), sizeof(RegionPackHeader));
+
+    if(header.marker!=RegionPackHeader_Marker)
+        return false;
+    if(header.version!=RegionPackHeader_Version)
+        return false;
+    if(header.chunkCount!=m_header.chunkCount)
+        return false;
+
+    std::vector<RegionPackEntry> entries(header.chunkCount);
+    uint64_t used=0;
+
+    memcpy(entries.data(), buffer.data()+sizeof(RegionPackHeader), entries.size()*sizeof(RegionPackEntry));
+
+    //entries pointing outside the file mean the table is damaged
+    for(RegionPackEntry &entry:entries)
+    {
+        if(entry.offset==0)
+            continue;
+
+        if((entry.offset<m_dataOffset)||(entry.size>entry.capacity)||(entry.offset+entry.capacity>m_fileEnd))
+            return false;
+        used+=entry.capacity;
+    }
+
+    m_entries.swap(entries);
+    m_unused=(m_fileEnd-m_dataOffset)-used;
+    return true;
+}
+
+bool RegionPack::compact()
+{
+    //payloads packed back to back in chunk order
+    std::vector<RegionPackEntry> entries(m_entries);
+    uint64_t fileEnd=m_dataOffset;
+
+    for(RegionPackEntry &entry:entries)
+    {
+        if(entry.offset==0)
+            continue;
+
+        entry.offset=alignPackOffset(fileEnd);
+        entry.capacity=(uint32_t)alignPackOffset(entry.size);
+        fileEnd=entry.offset+entry.capacity;
+    }
+
+    std::string tempFileName=m_fileName+".tmp";
+    std::ofstream file;
+
+    file.open(tempFileName, std::ofstream::out|std::ofstream::trunc|std::ofstream::binary);
+    if(!file.is_open())
+        return false;
+
+    std::vector<char> data(fileEnd, 0);
+
+    memcpy(data.data(), &m_header, sizeof(RegionPackHeader));
+    memcpy(data.data()+sizeof(RegionPackHeader), entries.data(), entries.size()*sizeof(RegionPackEntry));
+
+    for(size_t i=0; i<entries.size(); ++i)
+    {
+        if(entries[i].offset==0)
+            continue;
+
+        if(!readPayload(m_entries[i], data.data()+entries[i].offset))
+        {
+            file.close();
+            fs::remove(tempFileName);
+            return false;
+        }
+    }
+
+    file.write(data.data(), data.size());
+    file.close();
+
+    if(!file)
+    {
+        fs::remove(tempFileName);
+        return false;
+    }
+
+    m_file.close();
+    m_mapping.reset();
+
+    if(!fs::rename(tempFileName, m_fileName))
+    {
+        fs::remove(tempFileName);
+        m_file.open(m_fileName, std::fstream::in|std::fstream::out|std::fstream::binary);
+        return false;
+    }
+
+    m_file.open(m_fileName, std::fstream::in|std::fstream::out|std::fstream::binary);
+
+    m_entries.swap(entries);
+    m_fileEnd=fileEnd;
+    m_unused=0;
+    return m_file.is_open();
+}
+
+bool RegionPack::readPayload(const RegionPackEntry &entry, char *buffer)
+{
+    if(entry.size==0)
+        return true;
+
+    //only the chunk's own bytes are read, the region is never loaded as a whole
+    m_file.seekg(entry.offset, std::fstream::beg);
+    m_file.read(buffer, entry.size);
+
+    if(!m_file)
+    {
+        m_file.clear();
+        return false;
+    }
+    return true;
+}
+
+void RegionPack::close()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    //async reads handed out by locate are still using the native file
+    m_readEvent.wait(lock, [this] { return m_pendingReads==0; });
+
+    if(m_file.is_open())
+        m_file.close();
+
+#ifndef _WIN32
+    if(m_nativeFile>=0)
+        ::close(m_nativeFile);
+#endif
+    m_nativeFile=-1;
+
+    m_open=false;
+    m_entries.clear();
+    m_mapping.reset();
+}
+
+bool RegionPack::isOpen()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    return m_open;
+}
+
+bool RegionPack::contains(ChunkHash hash)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(hash>=m_entries.size())
+        return false;
+    return (m_entries[hash].flags&RegionPackFlags::Present)!=0;
+}
+
+size_t RegionPack::size(ChunkHash hash)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(hash>=m_entries.size())
+        return 0;
+    return m_entries[hash].size;
+}
+
+uint32_t RegionPack::flags(ChunkHash hash)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(hash>=m_entries.size())
+        return 0;
+    return m_entries[hash].flags;
+}
+
+uint32_t RegionPack::revision(ChunkHash hash)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(hash>=m_entries.size())
+        return 0;
+    return m_entries[hash].revision;
+}
+
+bool RegionPack::read(ChunkHash hash, char *buffer, size_t size)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(!openFile(false))
+        return false;
+
+    if(hash>=m_entries.size())
+        return false;
+
+    RegionPackEntry &entry=m_entries[hash];
+
+    if(!(entry.flags&RegionPackFlags::Present)||(entry.size!=size))
+        return false;
+
+    return readPayload(entry, buffer);
+}
+
+const char *RegionPack::view(ChunkHash hash, size_t size, SharedMappedFile &mapping)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(!openFile(false))
+        return nullptr;
+
+    if(hash>=m_entries.size())
+        return nullptr;
+
+    RegionPackEntry &entry=m_entries[hash];
+
+    if(!(entry.flags&RegionPackFlags::Present)||(entry.size!=size)||(size==0))
+        return nullptr;
+
+    if(!m_mapping||(entry.offset+entry.size>m_mapping->size()))
+    {
+        //chunks still holding the old mapping keep it alive
+        SharedMappedFile newMapping=std::make_shared<MappedFile>();
+
+        m_file.flush();
+        if(!newMapping->open(m_fileName))
+            return nullptr;
+
+        m_mapping=newMapping;
+    }
+
+    if(entry.offset+entry.size>m_mapping->size())
+        return nullptr;
+
+    mapping=m_mapping;
+    return m_mapping->data()+entry.offset;
+}
+
+int RegionPack::nativeFile()
+{
+#ifndef _WIN32
+    if(m_nativeFile<0)
+        m_nativeFile=::open(m_fileName.c_str(), O_RDONLY);
+#endif
+    return m_nativeFile;
+}
+
+bool RegionPack::locate(ChunkHash hash, int &file, uint64_t &offset, size_t &size, uint32_t &flags)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(!openFile(false))
+        return false;
+
+    if(hash>=m_entries.size())
+        return false;
+
+    RegionPackEntry &entry=m_entries[hash];
+
+    if(!(entry.flags&RegionPackFlags::Present)||(entry.size==0))
+        return false;
+
+    file=nativeFile();
+    if(file<0)
+        return false;
+
+    offset=entry.offset;
+    size=entry.size;
+    flags=entry.flags;
+    m_pendingReads++;
+    return true;
+}
+
+void RegionPack::endRead()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    assert(m_pendingReads>0);
+    m_pendingReads--;
+    //notify under the lock, close may destroy the pack as soon as it wakes
+    m_readEvent.notify_all();
+}
+
+bool RegionPack::write(ChunkHash hash, const char *buffer, size_t size, uint32_t flags, uint32_t revision)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if(!openFile(true))
+        return false;
+
+    if(hash>=m_entries.size())
+        return false;
+
+    RegionPackEntry &entry=m_entries[hash];
+
+    //re-use the slot if it fits, otherwise append to the end of the file, the old
+    //slot becomes a hole that is reclaimed when the pack is next opened
+    if((size>0)&&((entry.offset==0)||(entry.capacity<size)))
+    {
+        if(entry.offset!=0)
+            m_unused+=entry.capacity;
+
+        entry.offset=alignPackOffset(m_fileEnd);
+        entry.capacity=(uint32_t)alignPackOffset(size);
+        m_fileEnd=entry.offset+entry.capacity;
+    }
+    entry.size=(uint32_t)size;
+    entry.flags=flags|RegionPackFlags::Present;
+    entry.revision=revision;
+
+    if(size>0)
+    {
+        std::vector<char> padding(entry.capacity-size, 0);
+
+        m_file.seekp(entry.offset, std::fstream::beg);
+        m_file.write(buffer, size);
+        if(!padding.empty())
+            m_file.write(padding.data(), padding.size());
+    }
+
+    m_file.seekp(sizeof(RegionPackHeader)+hash*sizeof(RegionPackEntry), std::fstream::beg);
+    m_file.write((char *)&entry, sizeof(RegionPackEntry));
+    m_file.flush();
+
+    if(!m_file)
+    {
+        m_file.clear();
+        return false;
+    }
+    return true;
+}
+
+void RegionPack::release()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_mapping.reset();
+}
+
+} //namespace voxigen
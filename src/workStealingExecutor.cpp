@@ -0,0 +1,420 @@
+#include "voxigen/workStealingExecutor.h"
+#include "voxigen/fileio/log.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace voxigen
+{
+
+WorkStealingExecutor::WorkStealingExecutor(std::condition_variable *completeEvent):
+    m_completeEvent(completeEvent),
+    m_nextWorker(0),
+    m_run(false),
+    m_pending(0)
+{
+    processRequest=std::bind(&WorkStealingExecutor::defaultCallback, this, std::placeholders::_1);
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+}
+
+void WorkStealingExecutor::setCallback(process::Callback callback)
+{
+    processRequest=callback;
+}
+
+void WorkStealingExecutor::start(size_t threadCount)
+{
+    if(threadCount<1)
+        threadCount=1;
+
+    m_workers.clear();
+    for(size_t i=0; i<threadCount; ++i)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+
+        Worker &worker=*m_workers.back();
+
+        worker.count=0;
+        worker.version=0;
+        worker.rekeyBucket=BucketCount;
+        worker.rekeyEntry=0;
+        worker.region=process::Compare::currentRegion;
+        worker.chunk=process::Compare::currentChunk;
+    }
+
+    m_run=true;
+    for(size_t i=0; i<threadCount; ++i)
+    {
+        std::thread workerThread=std::thread(std::bind(&WorkStealingExecutor::process, this, i));
+
+        m_threads.push_back(std::move(workerThread));
+    }
+}
+
+void WorkStealingExecutor::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_run=false;
+    }
+
+    m_event.notify_all();
+    for(size_t i=0; i<m_threads.size(); ++i)
+        m_threads[i].join();
+    m_threads.clear();
+}
+
+void WorkStealingExecutor::updateQueue(RequestQueue &queue, RequestQueue &cancelQueue, RequestQueue &completedQueue, bool forceResort)
+{
+    assert(!m_workers.empty());
+
+    if(!cancelQueue.empty())
+    {
+        for(auto &worker:m_workers)
+        {
+            std::unique_lock<std::mutex> lock(worker->mutex);
+
+            removeRequests(*worker, cancelQueue, completedQueue);
+        }
+
+        //cancels are separate requests, all of them are handed back
+        completedQueue.insert(completedQueue.end(), cancelQueue.begin(), cancelQueue.end());
+        cancelQueue.clear();
+    }
+
+    //position changed, entries are re-keyed as they are popped
+    if(forceResort)
+    {
+        for(auto &worker:m_workers)
+        {
+            std::unique_lock<std::mutex> lock(worker->mutex);
+
+            worker->version++;
+            worker->region=process::Compare::currentRegion;
+            worker->chunk=process::Compare::currentChunk;
+            worker->rekeyBucket=0;
+            worker->rekeyEntry=0;
+        }
+    }
+
+    if(!queue.empty())
+    {
+        size_t workerCount=m_workers.size();
+
+        //deal requests out round robin, one lock per worker
+        for(size_t i=0; i<workerCount; ++i)
+        {
+            size_t workerIndex=(m_nextWorker+i)%workerCount;
+            Worker &worker=*m_workers[workerIndex];
+            std::unique_lock<std::mutex> lock(worker.mutex);
+
+            for(size_t j=i; j<queue.size(); j+=workerCount)
+            {
+                process::Request *request=queue[j];
+
+#ifdef DEBUG_THREAD
+                Log::debug("WorkStealingExecutor inserting %llx into worker %d", request, workerIndex);
+#endif//DEBUG_THREAD
+                worker.buckets[getBucket(request, worker.region, worker.chunk)].push_back({request, worker.version});
+                worker.count++;
+            }
+        }
+
+        m_nextWorker=(m_nextWorker+queue.size())%workerCount;
+        m_pending+=queue.size();
+        queue.clear();
+
+        //make sure sleeping workers are waiting before notifying
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+        }
+        m_event.notify_all();
+    }
+
+    for(auto &worker:m_workers)
+    {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+
+        if(!worker->completed.empty())
+        {
+#ifdef DEBUG_THREAD
+            for(process::Request *request:worker->completed)
+                Log::debug("WorkStealingExecutor completed request %llx", request);
+#endif//DEBUG_THREAD
+            completedQueue.insert(completedQueue.end(), worker->completed.begin(), worker->completed.end());
+            worker->completed.clear();
+        }
+    }
+}
+
+void WorkStealingExecutor::process(size_t index)
+{
+    Worker &worker=*m_workers[index];
+    size_t idle=0;
+
+    while(m_run)
+    {
+        process::Request *request=popRequest(index);
+
+        if(!request)
+            request=stealRequest(index);
+
+        if(!request)
+        {
+            //requests are pending but could not be taken (victims locked or being drained),
+            //spin a little then yield then park with a timeout instead of looping
+            if(m_pending>0)
+            {
+                idle++;
+                if(idle<=IdleSpins)
+                    continue;
+                if(idle<=IdleSpins+IdleYields)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                if(m_run)
+                    m_event.wait_for(lock, std::chrono::microseconds((long long)IdleWait));
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_event.wait(lock, [this] { return !m_run||(m_pending>0); });
+            idle=0;
+            continue;
+        }
+        idle=0;
+
+#ifdef DEBUG_THREAD
+        Log::debug("WorkStealingExecutor worker %d processing request %llx", index, request);
+#endif//DEBUG_THREAD
+        processRequest(request);
+
+        {
+            std::unique_lock<std::mutex> lock(worker.mutex);
+
+            worker.completed.push_back(request);
+        }
+        m_completeEvent->notify_all();
+    }
+}
+
+size_t WorkStealingExecutor::getBucket(const process::Request *request, const glm::ivec3 &region, const glm::ivec3 &chunk)
+{
+    size_t level;
+
+    if(request->priority<=process::Priority::CancelMesh)
+        level=0;
+    else if(request->priority<=process::Priority::UpdatePos)
+        level=1;
+    else if(request->priority<=process::Priority::Generate)
+        level=2;
+    else
+        level=3;
+
+    size_t ring=(size_t)request->ringDistance(region, chunk);
+    size_t distanceLevel=std::min(ring, DistanceLevels-1);
+
+    return (level*DistanceLevels)+distanceLevel;
+}
+
+void WorkStealingExecutor::rekey(Worker &worker)
+{
+    size_t examined=0;
+
+    while((worker.rekeyBucket<BucketCount) && (examined<RekeyLimit))
+    {
+        auto &bucket=worker.buckets[worker.rekeyBucket];
+
+        if(worker.rekeyEntry>=bucket.size())
+        {
+            worker.rekeyBucket++;
+            worker.rekeyEntry=0;
+            continue;
+        }
+
+        Entry &entry=bucket[worker.rekeyEntry];
+
+        examined++;
+        if(entry.version==worker.version)
+        {
+            worker.rekeyEntry++;
+            continue;
+        }
+
+        size_t index=getBucket(entry.request, worker.region, worker.chunk);
+
+        entry.version=worker.version;
+        if(index==worker.rekeyBucket)
+        {
+            worker.rekeyEntry++;
+            continue;
+        }
+
+        //closer or further away, entries moved behind the sweep are already current
+        worker.buckets[index].push_back(entry);
+        bucket.erase(bucket.begin()+worker.rekeyEntry);
+    }
+}
+
+process::Request *WorkStealingExecutor::popRequest(size_t index)
+{
+    Worker &worker=*m_workers[index];
+    std::unique_lock<std::mutex> lock(worker.mutex);
+
+    if(worker.count==0)
+        return nullptr;
+
+    rekey(worker);
+
+    size_t rekeyed=0;
+
+    for(size_t i=0; i<BucketCount; ++i)
+    {
+        auto &bucket=worker.buckets[i];
+
+        while(!bucket.empty())
+        {
+            Entry &entry=bucket.front();
+
+            //not swept yet, if it fell back move it. If it moved closer it is still the
+            //best entry as the buckets before this one are empty
+            if((entry.version!=worker.version) && (rekeyed<RekeyLimit))
+            {
+                size_t index=getBucket(entry.request, worker.region, worker.chunk);
+
+                entry.version=worker.version;
+                rekeyed++;
+
+                if(index>i)
+                {
+                    worker.buckets[index].push_back(entry);
+                    bucket.pop_front();
+                    if((i==worker.rekeyBucket) && (worker.rekeyEntry>0))
+                        worker.rekeyEntry--;
+                    continue;
+                }
+            }
+
+            process::Request *request=entry.request;
+
+            bucket.pop_front();
+            if((i==worker.rekeyBucket) && (worker.rekeyEntry>0))
+                worker.rekeyEntry--;
+            worker.count--;
+            m_pending--;
+            return request;
+        }
+    }
+    return nullptr;
+}
+
+process::Request *WorkStealingExecutor::stealRequest(size_t index)
+{
+    size_t workerCount=m_workers.size();
+
+    for(size_t i=1; i<workerCount; ++i)
+    {
+        Worker &victim=*m_workers[(index+i)%workerCount];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+
+        //busy, try the next one
+        if(!lock.owns_lock() || (victim.count==0))
+            continue;
+
+        //take the best bucket from the back, the owner works from the front
+        for(auto &bucket:victim.buckets)
+        {
+            if(bucket.empty())
+                continue;
+
+            process::Request *request=bucket.back().request;
+
+            bucket.pop_back();
+            victim.count--;
+            m_pending--;
+            return request;
+        }
+    }
+    return nullptr;
+}
+
+bool WorkStealingExecutor::cancels(const process::Request *cancel, const process::Request *request)
+{
+    return (cancel->type==process::Type::CancelGenerate)&&(request->type==process::Type::Generate)&&
+        (cancel->data.chunk.handle==request->data.chunk.handle);
+}
+
+bool WorkStealingExecutor::canceled(const process::Request *request, const RequestQueue &cancelQueue)
+{
+    for(const process::Request *cancel:cancelQueue)
+    {
+        if(cancels(cancel, request))
+            return true;
+    }
+    return false;
+}
+
+void WorkStealingExecutor::removeRequests(Worker &worker, RequestQueue &cancelQueue, RequestQueue &completed)
+{
+    if(worker.count==0)
+        return;
+
+    for(auto &bucket:worker.buckets)
+    {
+        for(size_t i=0; i<bucket.size(); )
+        {
+            process::Request *request=bucket[i].request;
+
+            //batch members are only linked from the queued request, the batch is not
+            //being generated while its first request is queued so it can be unlinked here
+            process::Request *previous=request;
+
+            while(previous->batch)
+            {
+                process::Request *batchRequest=previous->batch;
+
+                if(!canceled(batchRequest, cancelQueue))
+                {
+                    previous=batchRequest;
+                    continue;
+                }
+
+                previous->batch=batchRequest->batch;
+                batchRequest->batch=nullptr;
+                batchRequest->result=process::Result::Canceled;
+                completed.push_back(batchRequest);
+            }
+
+            if(!canceled(request, cancelQueue))
+            {
+                ++i;
+                continue;
+            }
+
+            //set request as canceled and add to completed, ProcessThread queues the rest
+            //of its batch again
+            request->result=process::Result::Canceled;
+            completed.push_back(request);
+
+            bucket.erase(bucket.begin()+i);
+            worker.count--;
+            m_pending--;
+            //entries shifted, restart an unfinished sweep
+            if(worker.rekeyBucket<BucketCount)
+            {
+                worker.rekeyBucket=0;
+                worker.rekeyEntry=0;
+            }
+        }
+    }
+}
+
+}//namespace voxigen
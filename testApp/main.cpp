@@ -147,6 +147,9 @@ void loadThreadFunc()
     std::string worldName=defaultWorldName;
     std::string worldDirectory=worldsDirectory.string()+"/"+worldName;
 
+    //chunks loaded from disk view the region packs until edited
+    world.setMappedRead(true);
+
     if(!worldDirectories.empty())
     {
         for(size_t i=0; i<worldDirectories.size(); ++i)
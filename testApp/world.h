@@ -8,9 +8,11 @@
 #include "voxigen/generators/equiRectWorldGenerator.h"
 
 static std::string defaultWorldName="TestAppWorld";
-typedef voxigen::RegularGrid<voxigen::Cell, 64, 64, 16> World;
+//typedef voxigen::RegularGrid<voxigen::Cell, 64, 64, 16> World;
 //static std::string defaultWorldName="TestAppWorld_128";
 //typedef voxigen::RegularGrid<voxigen::Cell, 128, 128, 128> World;
+//palette compressed chunks
+typedef voxigen::RegularGrid<voxigen::Cell, 64, 64, 16, 16, 16, 16, true, voxigen::PaletteStorage<voxigen::Cell>> World;
 
 namespace voxigen
 {
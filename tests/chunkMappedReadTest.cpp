@@ -0,0 +1,157 @@
+#include "testing.h"
+
+#include "voxigen/volume/cell.h"
+#include "voxigen/volume/regularGrid.h"
+#include "voxigen/fileio/simpleFilesystem.h"
+
+#include <vector>
+#include <string>
+
+using namespace voxigen;
+
+typedef RegularGrid<Cell, 64, 64, 16, 16, 16, 16, false> DenseWorld;
+typedef RegularGrid<Cell, 64, 64, 16, 16, 16, 16, false, PaletteStorage<Cell>> PaletteWorld;
+
+const glm::ivec3 WorldSize(204800, 102400, 10240);
+const glm::ivec3 ChunkSize(64, 64, 16);
+const size_t ChunkCells=64*64*16;
+
+Cell cellAt(const glm::ivec3 &position, unsigned int seed)
+{
+    Cell cell;
+
+    //a few layers so the palette stays small
+    cell.type=(position.z<4)?seed:((position.z<8)?seed+1:((position.x+position.y)%3==0?seed+2:0));
+    return cell;
+}
+
+std::vector<Cell> chunkCells(unsigned int seed)
+{
+    std::vector<Cell> cells(ChunkCells);
+
+    for(int z=0; z<ChunkSize.z; ++z)
+    {
+        for(int y=0; y<ChunkSize.y; ++y)
+        {
+            for(int x=0; x<ChunkSize.x; ++x)
+                cells[(ChunkSize.x*ChunkSize.y)*z+ChunkSize.x*y+x]=cellAt(glm::ivec3(x, y, z), seed);
+        }
+    }
+    return cells;
+}
+
+template<typename _ChunkHandle>
+bool sameCells(_ChunkHandle &handle, unsigned int seed)
+{
+    typename _ChunkHandle::ChunkType *chunk=handle.chunk();
+
+    for(int z=0; z<ChunkSize.z; ++z)
+    {
+        for(int y=0; y<ChunkSize.y; ++y)
+        {
+            for(int x=0; x<ChunkSize.x; ++x)
+            {
+                glm::ivec3 position(x, y, z);
+
+                if(chunk->getCell(glm::vec3(position)).type!=cellAt(position, seed).type)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename _World>
+void mappedRead(const std::string &directory)
+{
+    typedef typename _World::ChunkHandleType ChunkHandle;
+
+    std::string packFileName=directory+"/region.pack";
+    size_t chunkCount=16*16*16;
+
+    fs::remove(packFileName);
+
+    GridDescriptors<_World> descriptors;
+
+    descriptors.create("chunkMappedReadTest", 0, WorldSize);
+    descriptors.init();
+
+    RegionPack pack;
+
+    pack.setFile(packFileName, chunkCount);
+    VOXIGEN_CHECK(pack.open(true));
+
+    //chunk with cells and a uniform chunk
+    {
+        std::vector<Cell> cells=chunkCells(3);
+        ChunkHandle handle(0, glm::ivec3(0, 0, 0), 1, descriptors.getChunkIndex(1));
+
+        VOXIGEN_CHECK(handle.readData(&descriptors, (const char *)cells.data(), cells.size()*sizeof(Cell), CellEncoding::Dense, 7));
+        handle.chunk()->pack();
+        VOXIGEN_CHECK(handle.write(&descriptors, &pack));
+
+        Cell solid;
+
+        solid.type=5;
+        ChunkHandle uniformHandle(0, glm::ivec3(0, 0, 0), 2, descriptors.getChunkIndex(2));
+
+        VOXIGEN_CHECK(uniformHandle.readData(&descriptors, (const char *)&solid, sizeof(Cell), CellEncoding::Uniform, 0));
+        VOXIGEN_CHECK(uniformHandle.write(&descriptors, &pack));
+    }
+
+    ChunkHandle handle(0, glm::ivec3(0, 0, 0), 1, descriptors.getChunkIndex(1));
+
+    VOXIGEN_CHECK(handle.readMapped(&descriptors, &pack));
+    VOXIGEN_CHECK(handle.chunk()!=nullptr);
+    if(!handle.chunk())
+        return;
+
+    VOXIGEN_CHECK(handle.chunk()->isView());
+    VOXIGEN_CHECK(handle.memoryUsed()==0);
+    VOXIGEN_CHECK(handle.chunk()->getRevision()==7);
+    VOXIGEN_CHECK(sameCells(handle, 3));
+    //reading does not copy the cells out of the file
+    VOXIGEN_CHECK(handle.chunk()->isView());
+    VOXIGEN_CHECK(handle.chunk()->memoryUsed()==0);
+
+    //viewed chunk is written back without touching the pack
+    VOXIGEN_CHECK(handle.write(&descriptors, &pack));
+
+    //edit copies the cells out of the view
+    Cell cell;
+
+    cell.type=9;
+    handle.chunk()->setCell(glm::ivec3(1, 2, 3), cell);
+    VOXIGEN_CHECK(!handle.chunk()->isView());
+    VOXIGEN_CHECK(handle.chunk()->getCell(glm::vec3(1.0f, 2.0f, 3.0f)).type==9);
+    VOXIGEN_CHECK(handle.chunk()->getCell(glm::vec3(2.0f, 2.0f, 3.0f)).type==cellAt(glm::ivec3(2, 2, 3), 3).type);
+
+    //uniform chunk has nothing to view
+    ChunkHandle uniformHandle(0, glm::ivec3(0, 0, 0), 2, descriptors.getChunkIndex(2));
+
+    VOXIGEN_CHECK(uniformHandle.readMapped(&descriptors, &pack));
+    VOXIGEN_CHECK(uniformHandle.chunk()!=nullptr);
+    if(!uniformHandle.chunk())
+        return;
+
+    VOXIGEN_CHECK(uniformHandle.chunk()->isUniform());
+    VOXIGEN_CHECK(uniformHandle.chunk()->getCell(glm::vec3(10.0f, 20.0f, 5.0f)).type==5);
+    VOXIGEN_CHECK(uniformHandle.chunk()->isUniform());
+
+    //missing chunk
+    ChunkHandle missingHandle(0, glm::ivec3(0, 0, 0), 3, descriptors.getChunkIndex(3));
+
+    VOXIGEN_CHECK(!missingHandle.readMapped(&descriptors, &pack));
+}
+
+int main(int argc, char *argv[])
+{
+    std::string directory="chunkMappedReadTest";
+
+    fs::create_directory(directory);
+
+    mappedRead<DenseWorld>(directory);
+    mappedRead<PaletteWorld>(directory);
+
+    return testing::testResult();
+}
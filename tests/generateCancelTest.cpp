@@ -0,0 +1,166 @@
+#include "testing.h"
+
+#include "voxigen/workStealingExecutor.h"
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace voxigen;
+
+typedef WorkStealingExecutor::RequestQueue RequestQueue;
+
+struct Generator
+{
+    std::mutex mutex;
+    std::condition_variable event;
+    bool blocked=false;
+    bool release=false;
+
+    process::Request *blocker=nullptr;
+    std::vector<void *> generated;
+
+    //holds the worker on the blocker so everything queued after it stays queued
+    bool generate(process::Request *request)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if(request==blocker)
+        {
+            blocked=true;
+            event.notify_all();
+            event.wait(lock, [this] { return release; });
+        }
+
+        for(process::Request *batchRequest=request; batchRequest; batchRequest=batchRequest->batch)
+            generated.push_back(batchRequest->data.chunk.handle);
+        request->result=process::Result::Success;
+        return true;
+    }
+};
+
+process::Request generateRequest(void *handle, size_t priority)
+{
+    process::Request request(process::Type::Generate, priority);
+
+    request.position.region=glm::ivec3(0, 0, 0);
+    request.position.chunk=glm::ivec3(0, 0, 0);
+    request.result=process::Result::Success;
+    request.batch=nullptr;
+    request.data.chunk.handle=handle;
+    request.data.chunk.lod=0;
+    return request;
+}
+
+process::Request cancelRequest(void *handle)
+{
+    process::Request request(process::Type::CancelGenerate, 0);
+
+    request.batch=nullptr;
+    request.data.chunk.handle=handle;
+    request.data.chunk.lod=0;
+    return request;
+}
+
+bool contains(const RequestQueue &queue, process::Request *request)
+{
+    return std::find(queue.begin(), queue.end(), request)!=queue.end();
+}
+
+int main(int argc, char *argv[])
+{
+    process::Request::regionSize=glm::ivec3(16, 16, 16);
+    process::Request::chunkSize=glm::ivec3(64, 64, 16);
+
+    int handles[6];
+    process::Request blocker=generateRequest(&handles[0], 0);
+    process::Request leader=generateRequest(&handles[1], 1);
+    process::Request member1=generateRequest(&handles[2], 1);
+    process::Request member2=generateRequest(&handles[3], 1);
+    process::Request member3=generateRequest(&handles[4], 1);
+    process::Request single=generateRequest(&handles[5], 1);
+
+    //batch as ProcessThread links it, leader->member3->member2->member1
+    leader.batch=&member3;
+    member3.batch=&member2;
+    member2.batch=&member1;
+
+    std::condition_variable completeEvent;
+    WorkStealingExecutor executor(&completeEvent);
+    Generator generator;
+    RequestQueue queue;
+    RequestQueue cancelQueue;
+    RequestQueue completed;
+
+    generator.blocker=&blocker;
+    executor.setCallback([&generator](process::Request *request) { return generator.generate(request); });
+    executor.start(1);
+
+    queue.push_back(&blocker);
+    executor.updateQueue(queue, cancelQueue, completed, false);
+    {
+        std::unique_lock<std::mutex> lock(generator.mutex);
+
+        generator.event.wait(lock, [&generator] { return generator.blocked; });
+    }
+
+    queue.push_back(&leader);
+    queue.push_back(&single);
+    executor.updateQueue(queue, cancelQueue, completed, false);
+
+    //members in the middle and at the end of the batch, and a request with no batch
+    process::Request cancelMember2=cancelRequest(&handles[3]);
+    process::Request cancelMember1=cancelRequest(&handles[2]);
+    process::Request cancelSingle=cancelRequest(&handles[5]);
+
+    cancelQueue.push_back(&cancelMember2);
+    cancelQueue.push_back(&cancelMember1);
+    cancelQueue.push_back(&cancelSingle);
+    executor.updateQueue(queue, cancelQueue, completed, false);
+
+    VOXIGEN_CHECK(cancelQueue.empty());
+    VOXIGEN_CHECK(completed.size()==6);
+    VOXIGEN_CHECK(contains(completed, &member1));
+    VOXIGEN_CHECK(contains(completed, &member2));
+    VOXIGEN_CHECK(contains(completed, &single));
+    VOXIGEN_CHECK(contains(completed, &cancelMember1));
+    VOXIGEN_CHECK(contains(completed, &cancelMember2));
+    VOXIGEN_CHECK(contains(completed, &cancelSingle));
+    VOXIGEN_CHECK(member1.result==process::Result::Canceled);
+    VOXIGEN_CHECK(member2.result==process::Result::Canceled);
+    VOXIGEN_CHECK(single.result==process::Result::Canceled);
+    VOXIGEN_CHECK(member1.batch==nullptr);
+    VOXIGEN_CHECK(member2.batch==nullptr);
+    VOXIGEN_CHECK(leader.batch==&member3);
+    VOXIGEN_CHECK(member3.batch==nullptr);
+
+    //let the worker run the rest
+    {
+        std::unique_lock<std::mutex> lock(generator.mutex);
+
+        generator.release=true;
+    }
+    generator.event.notify_all();
+
+    completed.clear();
+    for(size_t i=0; (i<1000)&&(completed.size()<2); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        executor.updateQueue(queue, cancelQueue, completed, false);
+    }
+    executor.stop();
+
+    VOXIGEN_CHECK(completed.size()==2);
+    VOXIGEN_CHECK(contains(completed, &blocker));
+    VOXIGEN_CHECK(contains(completed, &leader));
+    VOXIGEN_CHECK(leader.result==process::Result::Success);
+
+    std::vector<void *> expected={&handles[0], &handles[1], &handles[4]};
+
+    VOXIGEN_CHECK(generator.generated==expected);
+
+    return testing::testResult();
+}
@@ -0,0 +1,92 @@
+#include "testing.h"
+#include "testWorld.h"
+
+#include "voxigen/fileio/simpleFilesystem.h"
+
+#include <vector>
+#include <string>
+
+using namespace voxigen;
+using namespace voxigen::testing;
+
+//classified chunks have to match the chunk built from the column, every chunk of the column is checked
+void checkColumn(WorldGenerator *generator, const glm::ivec2 &column, size_t &classifiedCount)
+{
+    std::vector<Cell> classified(ChunkCells);
+    std::vector<Cell> filled(ChunkCells);
+
+    for(int z=0; z<WorldSize.z; z+=ChunkSize.z)
+    {
+        glm::vec3 startPos(column.x, column.y, z);
+        unsigned int classifiedValid;
+
+        if(!generator->classifyChunk(startPos, ChunkSize, 0, classified.data(), classified.size()*sizeof(Cell), classifiedValid))
+            continue;
+
+        bool uniform;
+        unsigned int filledValid=generator->generateChunk(startPos, ChunkSize, filled.data(), filled.size()*sizeof(Cell), 0, uniform);
+        size_t cellCount=uniform?1:ChunkCells;
+        bool match=true;
+
+        for(size_t i=0; i<cellCount; ++i)
+        {
+            if(filled[i].type!=classified[0].type)
+            {
+                match=false;
+                break;
+            }
+        }
+
+        if(!VOXIGEN_CHECK(match) || !VOXIGEN_CHECK(filledValid==classifiedValid))
+            printf("  chunk (%d, %d, %d)\n", column.x, column.y, z);
+        classifiedCount++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string directory="generatorClassifyTest";
+
+    fs::create_directory(directory);
+
+    GridDescriptors<World> descriptors;
+    WorldGeneratorTemplate generatorTemplate;
+    LoadProgress progress;
+
+    descriptors.create("generatorClassifyTest", 0, WorldSize);
+    descriptors.init();
+    generatorTemplate.saveDescriptors(&descriptors);
+    //nothing saved in the directory, always a new overview
+    generatorTemplate.load(&descriptors, directory, progress);
+
+    WorldGenerator *generator=generatorTemplate.get();
+
+    //every chunk gets built from the column, classification only through classifyChunk
+    generator->setClassifyChunks(false);
+
+    glm::ivec2 influenceSize=generator->getInfluenceMapSize();
+    glm::ivec2 influenceGridSize(WorldSize.x/influenceSize.x, WorldSize.y/influenceSize.y);
+    std::vector<glm::ivec2> columns;
+    ColumnPicker picker(12345);
+
+    for(size_t i=0; i<48; ++i)
+    {
+        glm::ivec2 column=picker.next();
+
+        columns.push_back(column);
+        //far corner of the influence cell, blend weights run past 1 there
+        glm::ivec2 cell=column/influenceGridSize;
+
+        columns.push_back((cell+1)*influenceGridSize-glm::ivec2(ChunkSize.x, ChunkSize.y));
+    }
+
+    size_t classifiedCount=0;
+
+    for(const glm::ivec2 &column:columns)
+        checkColumn(generator, column, classifiedCount);
+
+    //most of a column is air or solid
+    VOXIGEN_CHECK(classifiedCount>columns.size()*(WorldSize.z/ChunkSize.z)/2);
+
+    return testing::testResult();
+}
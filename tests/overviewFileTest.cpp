@@ -0,0 +1,179 @@
+#include "testing.h"
+#include "testWorld.h"
+
+#include "voxigen/fileio/simpleFilesystem.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstdint>
+
+using namespace voxigen;
+using namespace voxigen::testing;
+
+struct FieldData
+{
+    const char *data;
+    size_t bytes;
+};
+
+std::vector<FieldData> fieldData(const InfluenceMap &map)
+{
+    std::vector<FieldData> fields;
+
+    //forEachArray only hands out mutable arrays, nothing is written here
+    const_cast<InfluenceMap &>(map).forEachArray([&fields](auto &array)
+    {
+        fields.push_back({(const char *)array.data(), array.size()*sizeof(array[0])});
+    });
+    return fields;
+}
+
+bool sameMap(const InfluenceMap &map1, const InfluenceMap &map2)
+{
+    std::vector<FieldData> fields1=fieldData(map1);
+    std::vector<FieldData> fields2=fieldData(map2);
+
+    for(size_t i=0; i<fields1.size(); ++i)
+    {
+        if(fields1[i].bytes!=fields2[i].bytes)
+            return false;
+        if(memcmp(fields1[i].data, fields2[i].data, fields1[i].bytes)!=0)
+            return false;
+    }
+    return true;
+}
+
+bool alignedMap(const InfluenceMap &map)
+{
+    for(const FieldData &field:fieldData(map))
+    {
+        if(((uintptr_t)field.data%InfluenceMap_Alignment)!=0)
+            return false;
+    }
+    return true;
+}
+
+//chunks around the surface, the ones that use the neighbor heights and the noise
+bool sameChunks(WorldGenerator *generator1, WorldGenerator *generator2)
+{
+    std::vector<Cell> cells1(ChunkCells);
+    std::vector<Cell> cells2(ChunkCells);
+    ColumnPicker picker(54321);
+
+    for(size_t i=0; i<32; ++i)
+    {
+        glm::ivec2 column=picker.next();
+        int surface=generator1->getBaseHeight(glm::vec2(column));
+        int z=(surface/ChunkSize.z)*ChunkSize.z;
+
+        glm::vec3 startPos(column.x, column.y, z);
+        bool uniform1;
+        bool uniform2;
+        unsigned int valid1=generator1->generateChunk(startPos, ChunkSize, cells1.data(), cells1.size()*sizeof(Cell), 0, uniform1);
+        unsigned int valid2=generator2->generateChunk(startPos, ChunkSize, cells2.data(), cells2.size()*sizeof(Cell), 0, uniform2);
+
+        if((valid1!=valid2)||(uniform1!=uniform2))
+            return false;
+
+        size_t cellCount=uniform1?1:ChunkCells;
+
+        for(size_t j=0; j<cellCount; ++j)
+        {
+            if(cells1[j].type!=cells2[j].type)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string directory="overviewFileTest";
+    std::string overviewFileName=directory+"/overview.bin";
+    std::string normalizeFileName=directory+"/normalize.bin";
+
+    fs::create_directory(directory);
+    fs::remove(overviewFileName);
+    fs::remove(normalizeFileName);
+
+    GridDescriptors<World> descriptors;
+    LoadProgress progress;
+
+    descriptors.create("overviewFileTest", 0, WorldSize);
+    descriptors.init();
+
+    //generated, nothing on disk yet
+    WorldGeneratorTemplate generated;
+
+    generated.get()->setOverviewThreads(1);
+    generated.saveDescriptors(&descriptors);
+    VOXIGEN_CHECK(!generated.load(&descriptors, directory, progress));
+    VOXIGEN_CHECK(!generated.get()->getInfluenceMap().isMapped());
+
+    //overview passes split into the same blocks for any thread count
+    {
+        WorldGeneratorTemplate threaded;
+
+        threaded.get()->setOverviewThreads(4);
+        VOXIGEN_CHECK(!threaded.load(&descriptors, directory, progress));
+        VOXIGEN_CHECK(sameMap(generated.get()->getInfluenceMap(), threaded.get()->getInfluenceMap()));
+    }
+
+    generated.save(directory);
+    VOXIGEN_CHECK(fs::exists(overviewFileName));
+
+    //overview mapped in place, neighbor heights built and saved
+    WorldGeneratorTemplate mapped;
+
+    VOXIGEN_CHECK(!mapped.load(&descriptors, directory, progress));
+    VOXIGEN_CHECK(mapped.get()->getInfluenceMap().isMapped());
+    VOXIGEN_CHECK(alignedMap(mapped.get()->getInfluenceMap()));
+    VOXIGEN_CHECK(sameMap(generated.get()->getInfluenceMap(), mapped.get()->getInfluenceMap()));
+    VOXIGEN_CHECK(fs::exists(normalizeFileName));
+
+    //overview and neighbor heights both mapped
+    {
+        WorldGeneratorTemplate loaded;
+
+        VOXIGEN_CHECK(loaded.load(&descriptors, directory, progress));
+        VOXIGEN_CHECK(loaded.get()->getInfluenceMap().isMapped());
+        VOXIGEN_CHECK(sameMap(generated.get()->getInfluenceMap(), loaded.get()->getInfluenceMap()));
+        VOXIGEN_CHECK(sameChunks(generated.get(), loaded.get()));
+    }
+
+    //saving over the file a map is viewing
+    mapped.save(directory);
+    VOXIGEN_CHECK(!mapped.get()->getInfluenceMap().isMapped());
+    VOXIGEN_CHECK(sameMap(generated.get()->getInfluenceMap(), mapped.get()->getInfluenceMap()));
+
+    {
+        WorldGeneratorTemplate reloaded;
+
+        VOXIGEN_CHECK(reloaded.load(&descriptors, directory, progress));
+        VOXIGEN_CHECK(sameMap(generated.get()->getInfluenceMap(), reloaded.get()->getInfluenceMap()));
+    }
+
+    //truncated file is rejected and the overview generated again
+    {
+        std::ifstream file(overviewFileName, std::ifstream::binary);
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        file.close();
+        data.resize(data.size()/2);
+
+        std::ofstream truncated(overviewFileName, std::ofstream::binary|std::ofstream::trunc);
+
+        truncated.write(data.data(), data.size());
+    }
+
+    WorldGeneratorTemplate regenerated;
+
+    VOXIGEN_CHECK(!regenerated.load(&descriptors, directory, progress));
+    VOXIGEN_CHECK(!regenerated.get()->getInfluenceMap().isMapped());
+    VOXIGEN_CHECK(sameMap(generated.get()->getInfluenceMap(), regenerated.get()->getInfluenceMap()));
+
+    return testing::testResult();
+}
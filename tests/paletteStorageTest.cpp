@@ -0,0 +1,236 @@
+#include "testing.h"
+
+#include "voxigen/volume/cell.h"
+#include "voxigen/volume/chunk.h"
+
+#include <vector>
+#include <cstring>
+
+using namespace voxigen;
+
+typedef PaletteStorage<Cell> Storage;
+typedef Chunk<Cell, 32, 32, 16, Storage> PaletteChunk;
+
+const size_t CellCount=32*32*16;
+
+Cell makeCell(unsigned int type)
+{
+    Cell cell;
+
+    cell.type=type;
+    cell.damage=type*3;
+    cell.age=type^0x55;
+    return cell;
+}
+
+bool sameCell(const Cell &cell1, const Cell &cell2)
+{
+    return memcmp(&cell1, &cell2, sizeof(Cell))==0;
+}
+
+//cells using typeCount types, in runs so the last hit path and the lookup are both used
+std::vector<Cell> makeCells(size_t typeCount)
+{
+    std::vector<Cell> cells(CellCount);
+
+    for(size_t i=0; i<CellCount; ++i)
+        cells[i]=makeCell((unsigned int)(((i/3)*7919)%typeCount));
+    return cells;
+}
+
+bool matches(const Storage::View &view, const std::vector<Cell> &cells)
+{
+    if(view.size()!=cells.size())
+        return false;
+
+    for(size_t i=0; i<cells.size(); ++i)
+    {
+        if(!sameCell(view[i], cells[i]))
+            return false;
+    }
+    return true;
+}
+
+void packUnpack(size_t typeCount)
+{
+    std::vector<Cell> cells=makeCells(typeCount);
+    Storage storage;
+
+    storage.allocate(CellCount);
+    storage.getCells()=cells;
+    storage.pack();
+
+    Storage::View view=storage.getView();
+
+    VOXIGEN_CHECK(view.data()==nullptr);
+    VOXIGEN_CHECK(view.paletteSize()==typeCount);
+    VOXIGEN_CHECK(matches(view, cells));
+    VOXIGEN_CHECK(storage.memoryUsed()<CellCount*sizeof(Cell));
+
+    //write/load round trip
+    size_t size;
+    uint32_t encoding;
+    const char *data=storage.data(size, encoding);
+
+    VOXIGEN_CHECK(encoding==CellEncoding::Palette);
+
+    Storage loaded;
+
+    VOXIGEN_CHECK(loaded.load(data, size, encoding, CellCount));
+    VOXIGEN_CHECK(matches(loaded.getView(), cells));
+
+    //mutable access unpacks, pack drops the dense cells again
+    Storage::Cells &unpacked=storage.getCells();
+
+    VOXIGEN_CHECK(unpacked.size()==CellCount);
+    unpacked[5]=makeCell(100000);
+    cells[5]=unpacked[5];
+    storage.pack();
+    VOXIGEN_CHECK(storage.getView().data()==nullptr);
+    VOXIGEN_CHECK(storage.getView().paletteSize()==typeCount+1);
+    VOXIGEN_CHECK(matches(storage.getView(), cells));
+}
+
+void tooManyTypes()
+{
+    std::vector<Cell> cells(CellCount);
+
+    for(size_t i=0; i<CellCount; ++i)
+        cells[i]=makeCell((unsigned int)i*2+1);
+
+    //every cell different, larger than 16 bits of palette stays dense
+    std::vector<Cell> largeCells(70000);
+
+    for(size_t i=0; i<largeCells.size(); ++i)
+        largeCells[i]=makeCell((unsigned int)i);
+
+    Storage storage;
+
+    storage.allocate(largeCells.size());
+    storage.getCells()=largeCells;
+    storage.pack();
+    VOXIGEN_CHECK(storage.getView().data()!=nullptr);
+    VOXIGEN_CHECK(matches(storage.getView(), largeCells));
+
+    size_t size;
+    uint32_t encoding;
+
+    storage.data(size, encoding);
+    VOXIGEN_CHECK(encoding==CellEncoding::Dense);
+    VOXIGEN_CHECK(size==largeCells.size()*sizeof(Cell));
+
+    //all distinct but within the palette limit
+    Storage distinct;
+
+    distinct.allocate(CellCount);
+    distinct.getCells()=cells;
+    distinct.pack();
+    VOXIGEN_CHECK(distinct.getView().paletteSize()==CellCount);
+    VOXIGEN_CHECK(matches(distinct.getView(), cells));
+}
+
+//damaged packed data is rejected by load and setView instead of being read past its end
+void damaged()
+{
+    std::vector<Cell> cells=makeCells(3);
+    Storage storage;
+
+    storage.allocate(CellCount);
+    storage.getCells()=cells;
+    storage.pack();
+
+    size_t size;
+    uint32_t encoding;
+    const char *data=storage.data(size, encoding);
+    std::vector<char> packed(data, data+size);
+    Storage loaded;
+    DenseStorage<Cell> dense;
+
+    VOXIGEN_CHECK(loaded.load(packed.data(), packed.size(), encoding, CellCount));
+    VOXIGEN_CHECK(dense.load(packed.data(), packed.size(), encoding, CellCount));
+
+    //truncated
+    VOXIGEN_CHECK(!loaded.load(packed.data(), packed.size()-1, encoding, CellCount));
+    VOXIGEN_CHECK(!loaded.setView(packed.data(), packed.size()-1, encoding, CellCount, nullptr));
+    VOXIGEN_CHECK(!dense.load(packed.data(), packed.size()-1, encoding, CellCount));
+    VOXIGEN_CHECK(!loaded.load(packed.data(), sizeof(PaletteHeader)-1, encoding, CellCount));
+
+    PaletteHeader header;
+
+    memcpy(&header, packed.data(), sizeof(PaletteHeader));
+
+    //header fields past what the payload holds
+    std::vector<PaletteHeader> headers(4, header);
+
+    headers[0].bitsLog2=5;
+    headers[1].paletteBytes=0;
+    headers[2].paletteSize=0;
+    headers[3].paletteBytes+=8;
+
+    for(const PaletteHeader &badHeader:headers)
+    {
+        std::vector<char> bad=packed;
+
+        memcpy(bad.data(), &badHeader, sizeof(PaletteHeader));
+        VOXIGEN_CHECK(!loaded.load(bad.data(), bad.size(), encoding, CellCount));
+        VOXIGEN_CHECK(!loaded.setView(bad.data(), bad.size(), encoding, CellCount, nullptr));
+        VOXIGEN_CHECK(!dense.load(bad.data(), bad.size(), encoding, CellCount));
+    }
+
+    //3 entries in 2 bit indices, index 3 is past the palette
+    std::vector<char> bad=packed;
+    uint64_t *indices=(uint64_t *)(bad.data()+sizeof(PaletteHeader)+header.paletteBytes);
+
+    indices[0]|=3;
+    VOXIGEN_CHECK(!loaded.load(bad.data(), bad.size(), encoding, CellCount));
+    VOXIGEN_CHECK(!loaded.setView(bad.data(), bad.size(), encoding, CellCount, nullptr));
+    VOXIGEN_CHECK(!dense.load(bad.data(), bad.size(), encoding, CellCount));
+}
+
+void chunkEdits()
+{
+    PaletteChunk chunk(0, 0, glm::ivec3(0), glm::vec3(0.0f), 0);
+    std::vector<Cell> cells=makeCells(1);
+
+    chunk.getCells()=cells;
+    chunk.pack();
+    VOXIGEN_CHECK(chunk.isUniform());
+    VOXIGEN_CHECK(sameCell(chunk.getUniformCell(), cells[0]));
+
+    //edit expands the uniform chunk, clearDirty repacks it
+    Cell edit=makeCell(7);
+    glm::ivec3 index(3, 4, 5);
+    size_t cellIndex=(32*32)*index.z+32*index.y+index.x;
+
+    chunk.setCell(index, edit);
+    cells[cellIndex]=edit;
+    VOXIGEN_CHECK(!chunk.isUniform());
+    VOXIGEN_CHECK(chunk.isDirty());
+    VOXIGEN_CHECK(chunk.getRevision()==1);
+    VOXIGEN_CHECK(chunk.getCellView().data()!=nullptr);
+
+    chunk.clearDirty();
+    VOXIGEN_CHECK(!chunk.isDirty());
+    VOXIGEN_CHECK(chunk.getCellView().data()==nullptr);
+    VOXIGEN_CHECK(chunk.getCellView().paletteSize()==2);
+    VOXIGEN_CHECK(matches(chunk.getCellView(), cells));
+
+    //undoing the edit makes the chunk uniform again
+    chunk.setCell(index, cells[0]);
+    chunk.clearDirty();
+    VOXIGEN_CHECK(chunk.isUniform());
+}
+
+int main(int argc, char *argv[])
+{
+    size_t typeCounts[]={2, 3, 4, 5, 16, 17, 200, 256, 257, 5000};
+
+    for(size_t typeCount:typeCounts)
+        packUnpack(typeCount);
+
+    tooManyTypes();
+    damaged();
+    chunkEdits();
+
+    return voxigen::testing::testResult();
+}
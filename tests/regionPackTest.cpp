@@ -0,0 +1,272 @@
+#include "testing.h"
+
+#include "voxigen/volume/regionPack.h"
+#include "voxigen/fileio/simpleFilesystem.h"
+
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace voxigen;
+
+const size_t ChunkCount=64;
+
+std::vector<char> payload(size_t size, char seed)
+{
+    std::vector<char> data(size);
+
+    for(size_t i=0; i<size; ++i)
+        data[i]=(char)(seed+i*7);
+    return data;
+}
+
+uint64_t fileSize(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ifstream::binary|std::ifstream::ate);
+
+    return (uint64_t)file.tellg();
+}
+
+void roundTrip(const std::string &fileName)
+{
+    {
+        RegionPack pack;
+
+        pack.setFile(fileName, ChunkCount);
+        VOXIGEN_CHECK(!pack.open(false));
+        VOXIGEN_CHECK(pack.open(true));
+
+        for(ChunkHash hash=0; hash<ChunkCount; hash+=3)
+        {
+            std::vector<char> data=payload(100+hash, (char)hash);
+
+            VOXIGEN_CHECK(pack.write(hash, data.data(), data.size(), RegionPackFlags::Present, (uint32_t)hash*5));
+        }
+        VOXIGEN_CHECK(pack.write(1, nullptr, 0, RegionPackFlags::Empty));
+        VOXIGEN_CHECK(!pack.write(ChunkCount, nullptr, 0));
+    }
+
+    RegionPack pack;
+
+    pack.setFile(fileName, ChunkCount);
+    VOXIGEN_CHECK(pack.open(false));
+
+    for(ChunkHash hash=0; hash<ChunkCount; ++hash)
+    {
+        if(hash==1)
+        {
+            VOXIGEN_CHECK(pack.contains(hash));
+            VOXIGEN_CHECK((pack.flags(hash)&RegionPackFlags::Empty)!=0);
+            VOXIGEN_CHECK(pack.size(hash)==0);
+            continue;
+        }
+
+        if((hash%3)!=0)
+        {
+            VOXIGEN_CHECK(!pack.contains(hash));
+            continue;
+        }
+
+        std::vector<char> expected=payload(100+hash, (char)hash);
+        std::vector<char> data(pack.size(hash));
+
+        VOXIGEN_CHECK(data.size()==expected.size());
+        VOXIGEN_CHECK(pack.read(hash, data.data(), data.size()));
+        VOXIGEN_CHECK(data==expected);
+        VOXIGEN_CHECK(pack.revision(hash)==hash*5);
+
+        SharedMappedFile mapping;
+        const char *view=pack.view(hash, expected.size(), mapping);
+
+        VOXIGEN_CHECK(view!=nullptr);
+        if(view)
+            VOXIGEN_CHECK(memcmp(view, expected.data(), expected.size())==0);
+    }
+}
+
+void compaction(const std::string &fileName)
+{
+    const size_t chunks=4;
+    const size_t baseSize=100*1024;
+
+    //each re-write grows and moves the payload, leaving the old slots as holes
+    {
+        RegionPack pack;
+
+        pack.setFile(fileName, ChunkCount);
+        for(size_t pass=1; pass<=4; ++pass)
+        {
+            for(ChunkHash hash=0; hash<chunks; ++hash)
+            {
+                std::vector<char> data=payload(baseSize*pass, (char)(hash+pass));
+
+                VOXIGEN_CHECK(pack.write(hash, data.data(), data.size()));
+            }
+        }
+    }
+
+    uint64_t grownSize=fileSize(fileName);
+
+    RegionPack pack;
+
+    pack.setFile(fileName, ChunkCount);
+    VOXIGEN_CHECK(pack.open(false));
+
+    uint64_t compactSize=fileSize(fileName);
+
+    VOXIGEN_CHECK(compactSize<grownSize);
+    VOXIGEN_CHECK(compactSize<=sizeof(RegionPackHeader)+ChunkCount*sizeof(RegionPackEntry)+chunks*(baseSize*4+RegionPack_Alignment)+RegionPack_Alignment);
+
+    for(ChunkHash hash=0; hash<chunks; ++hash)
+    {
+        std::vector<char> expected=payload(baseSize*4, (char)(hash+4));
+        std::vector<char> data(pack.size(hash));
+
+        VOXIGEN_CHECK(pack.read(hash, data.data(), data.size()));
+        VOXIGEN_CHECK(data==expected);
+    }
+}
+
+void damaged(const std::string &fileName)
+{
+    {
+        std::ofstream file(fileName, std::ofstream::binary|std::ofstream::trunc);
+        std::vector<char> garbage(4096, 0x55);
+
+        file.write(garbage.data(), garbage.size());
+    }
+
+    RegionPack pack;
+
+    pack.setFile(fileName, ChunkCount);
+    VOXIGEN_CHECK(!pack.open(false));
+
+    //write starts a new pack, the damaged one is kept aside
+    std::vector<char> data=payload(256, 3);
+
+    VOXIGEN_CHECK(pack.write(5, data.data(), data.size()));
+    VOXIGEN_CHECK(fs::exists(fileName+".bad"));
+    pack.close();
+
+    VOXIGEN_CHECK(pack.open(false));
+
+    std::vector<char> readData(pack.size(5));
+
+    VOXIGEN_CHECK(pack.read(5, readData.data(), readData.size()));
+    VOXIGEN_CHECK(readData==data);
+}
+
+void rewrite(const std::string &fileName)
+{
+    RegionPack pack;
+
+    pack.setFile(fileName, ChunkCount);
+
+    std::vector<char> data=payload(512, 4);
+    std::vector<char> readData(data.size());
+
+    VOXIGEN_CHECK(pack.write(4, data.data(), data.size()));
+    VOXIGEN_CHECK(pack.read(4, readData.data(), readData.size()));
+    VOXIGEN_CHECK(readData==data);
+
+    //re-written in place and moved, reads come from the file so both are seen
+    std::vector<char> sameSize=payload(512, 5);
+    std::vector<char> grown=payload(2048, 6);
+
+    VOXIGEN_CHECK(pack.write(4, sameSize.data(), sameSize.size()));
+    VOXIGEN_CHECK(pack.read(4, readData.data(), readData.size()));
+    VOXIGEN_CHECK(readData==sameSize);
+
+    VOXIGEN_CHECK(pack.write(4, grown.data(), grown.size()));
+    readData.resize(grown.size());
+    VOXIGEN_CHECK(pack.read(4, readData.data(), readData.size()));
+    VOXIGEN_CHECK(readData==grown);
+
+#ifndef _WIN32
+    //async reads are still located after the pack has been read from
+    int file;
+    uint64_t offset;
+    size_t size;
+    uint32_t flags;
+
+    VOXIGEN_CHECK(pack.locate(4, file, offset, size, flags));
+    VOXIGEN_CHECK(size==grown.size());
+    VOXIGEN_CHECK(pread(file, readData.data(), size, offset)==(ssize_t)size);
+    VOXIGEN_CHECK(readData==grown);
+    pack.endRead();
+#endif
+}
+
+void pendingReads(const std::string &fileName)
+{
+#ifndef _WIN32
+    std::vector<char> data=payload(4096, 9);
+
+    {
+        RegionPack pack;
+
+        pack.setFile(fileName, ChunkCount);
+        VOXIGEN_CHECK(pack.write(2, data.data(), data.size()));
+    }
+
+    RegionPack pack;
+    int file;
+    uint64_t offset;
+    size_t size;
+    uint32_t flags;
+
+    pack.setFile(fileName, ChunkCount);
+    VOXIGEN_CHECK(pack.locate(2, file, offset, size, flags));
+    VOXIGEN_CHECK(size==data.size());
+
+    //close has to wait for the read to finish with the file
+    std::atomic<bool> closed(false);
+    std::thread closeThread([&] { pack.close(); closed=true; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    VOXIGEN_CHECK(!closed);
+
+    std::vector<char> readData(size);
+
+    VOXIGEN_CHECK(pread(file, readData.data(), size, offset)==(ssize_t)size);
+    VOXIGEN_CHECK(readData==data);
+
+    pack.endRead();
+    closeThread.join();
+    VOXIGEN_CHECK(closed);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    std::string directory="regionPackTest";
+
+    fs::create_directory(directory);
+
+    std::string fileName=directory+"/region.pak";
+
+    fs::remove(fileName);
+    roundTrip(fileName);
+
+    fs::remove(fileName);
+    compaction(fileName);
+
+    fs::remove(fileName);
+    fs::remove(fileName+".bad");
+    damaged(fileName);
+
+    fs::remove(fileName);
+    rewrite(fileName);
+
+    fs::remove(fileName);
+    pendingReads(fileName);
+
+    return testing::testResult();
+}
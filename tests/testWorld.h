@@ -0,0 +1,49 @@
+#ifndef _voxigen_testWorld_h_
+#define _voxigen_testWorld_h_
+
+#include "voxigen/volume/cell.h"
+#include "voxigen/volume/regularGrid.h"
+#include "voxigen/generators/equiRectWorldGenerator.h"
+
+//world and generator shared by the generator tests
+namespace voxigen
+{
+namespace testing
+{
+
+typedef RegularGrid<Cell, 64, 64, 16, 16, 16, 16, false> World;
+typedef EquiRectWorldGenerator<World> WorldGenerator;
+typedef GeneratorTemplate<WorldGenerator, generic::io::StdFileIO> WorldGeneratorTemplate;
+
+const glm::ivec3 WorldSize(204800, 102400, 10240);
+const glm::ivec3 ChunkSize(64, 64, 16);
+const size_t ChunkCells=64*64*16;
+
+//repeatable chunk aligned columns across the world, plain LCG so every platform picks the same ones
+class ColumnPicker
+{
+public:
+    ColumnPicker(unsigned int seed):m_random(seed) {}
+
+    glm::ivec2 next()
+    {
+        int x=pick(WorldSize.x/ChunkSize.x)*ChunkSize.x;
+        int y=pick(WorldSize.y/ChunkSize.y)*ChunkSize.y;
+
+        return glm::ivec2(x, y);
+    }
+
+private:
+    int pick(int count)
+    {
+        m_random=m_random*1664525u+1013904223u;
+        return (int)((m_random>>8)%count);
+    }
+
+    unsigned int m_random;
+};
+
+}//namespace testing
+}//namespace voxigen
+
+#endif //_voxigen_testWorld_h_
@@ -0,0 +1,38 @@
+#ifndef _voxigen_testing_h_
+#define _voxigen_testing_h_
+
+#include <cstdio>
+
+//minimal checks for the unit tests, a test executable returns testResult() from main
+namespace voxigen
+{
+namespace testing
+{
+
+inline int &failures() { static int count=0; return count; }
+
+inline bool check(bool value, const char *expression, const char *file, int line)
+{
+    if(!value)
+    {
+        printf("%s(%d): check failed: %s\n", file, line, expression);
+        failures()++;
+    }
+    return value;
+}
+
+inline int testResult()
+{
+    if(failures()>0)
+        printf("%d checks failed\n", failures());
+    else
+        printf("all checks passed\n");
+    return (failures()>0)?1:0;
+}
+
+}//namespace testing
+}//namespace voxigen
+
+#define VOXIGEN_CHECK(expression) voxigen::testing::check((expression), #expression, __FILE__, __LINE__)
+
+#endif //_voxigen_testing_h_